@@ -0,0 +1,66 @@
+using System;
+using csharp_fastpinvokeNamespace;
+
+public class runme
+{
+  class DerivedCallback : Callback {
+    public override bool check(bool b) {
+      return !b;
+    }
+  }
+
+  static void Main()
+  {
+    if (csharp_fastpinvoke.add(1.5, 2.0) != 3.5)
+      throw new Exception("add failed");
+    if (csharp_fastpinvoke.negate(true) || !csharp_fastpinvoke.negate(false))
+      throw new Exception("negate failed");
+    if (!csharp_fastpinvoke.is_positive(true, 1) || csharp_fastpinvoke.is_positive(false, 1))
+      throw new Exception("is_positive failed");
+
+    // The exception check is still made for functions that can throw
+    csharp_fastpinvoke.thrower(0);
+    try {
+      csharp_fastpinvoke.thrower(1);
+      throw new Exception("thrower failed");
+    } catch (ApplicationException) {
+    }
+
+    // const char * input is passed as UTF-8
+    if (csharp_fastpinvoke.length("hello") != 5)
+      throw new Exception("length failed");
+    if (csharp_fastpinvoke.length("h\u00e9llo") != 6)
+      throw new Exception("length UTF-8 failed");
+    if (csharp_fastpinvoke.length(null) != unchecked((uint)-1))
+      throw new Exception("length null failed");
+    string longString = new string('x', 1000);
+    if (csharp_fastpinvoke.length(longString) != 1000)
+      throw new Exception("length long string failed");
+    if (!csharp_fastpinvoke.equals("abc", "abc") || csharp_fastpinvoke.equals("abc", "abd"))
+      throw new Exception("equals failed");
+    if (csharp_fastpinvoke.echo("echo") != "echo")
+      throw new Exception("echo failed");
+    if (csharp_fastpinvoke.greeting() != "h\u00e9llo")
+      throw new Exception("greeting failed");
+
+    // const char * variable setters are passed as UTF-8 too
+    csharp_fastpinvoke.global_name = "gl\u00f6bal";
+    if (csharp_fastpinvoke.global_name != "gl\u00f6bal")
+      throw new Exception("global_name failed");
+
+    Named named = new Named("four");
+    if (named.length != 4)
+      throw new Exception("Named constructor failed");
+    named.flag = true;
+    if (!named.flag)
+      throw new Exception("Named flag failed");
+    named.name = "n\u00e4me";
+    if (named.name != "n\u00e4me")
+      throw new Exception("Named name failed");
+
+    if (CallbackHolder.check(new Callback(), true) != true)
+      throw new Exception("Callback failed");
+    if (CallbackHolder.check(new DerivedCallback(), true) != false)
+      throw new Exception("DerivedCallback failed");
+  }
+}
@@ -0,0 +1,91 @@
+using System;
+using csharp_lib_arrays_spanNamespace;
+
+public class runme
+{
+  static void Main()
+  {
+    {
+      int[] source = { 1, 2, 3, 4, 5 };
+      int[] target = new int[source.Length];
+
+      if (csharp_lib_arrays_span.arrayCopy(source, target) != 5)
+        throw new Exception("arrayCopy count wrong");
+      CompareArrays(source, target);
+
+      Span<int> partial = stackalloc int[3];
+      if (csharp_lib_arrays_span.arrayCopy(new ReadOnlySpan<int>(source, 1, 4), partial) != 3)
+        throw new Exception("arrayCopy partial count wrong");
+      CompareArrays(new int[] { 2, 3, 4 }, partial.ToArray());
+
+      if (csharp_lib_arrays_span.arraySum(source) != 15)
+        throw new Exception("arraySum wrong");
+      if (csharp_lib_arrays_span.arraySum(ReadOnlySpan<int>.Empty) != 0)
+        throw new Exception("arraySum empty wrong");
+
+      double[] values = { 1.0, 2.0, 3.0, 4.0 };
+      csharp_lib_arrays_span.arrayScale(new Span<double>(values, 2, 2), 10.0);
+      if (values[0] != 1.0 || values[1] != 2.0 || values[2] != 30.0 || values[3] != 40.0)
+        throw new Exception("arrayScale wrong");
+    }
+
+    {
+      Image image = new Image(8);
+
+      Span<byte> pixels = image.pixels();
+      if (pixels.Length != 8 || pixels[7] != 7)
+        throw new Exception("pixels wrong");
+      pixels[3] = 200;
+      if (image.pixel(3) != 200)
+        throw new Exception("pixels not backed by the vector");
+
+      ReadOnlySpan<byte> constPixels = image.constPixels();
+      if (constPixels.Length != 8 || constPixels[3] != 200)
+        throw new Exception("constPixels wrong");
+
+      Memory<double> samples = image.samples();
+      if (samples.Length != 8 || samples.Span[4] != 2.0)
+        throw new Exception("samples wrong");
+      samples.Slice(4).Span[0] = 42.0;
+      if (image.sample(4) != 42.0)
+        throw new Exception("samples not backed by the vector");
+
+      ReadOnlyMemory<double> constSamples = image.constSamples();
+      if (constSamples.Length != 8 || constSamples.Span[4] != 42.0)
+        throw new Exception("constSamples wrong");
+
+      using (System.Buffers.MemoryHandle handle = samples.Pin()) {
+        unsafe {
+          if (((double *)handle.Pointer)[4] != 42.0)
+            throw new Exception("pinned samples wrong");
+        }
+      }
+      GC.KeepAlive(image);
+    }
+
+    {
+      // The Memory<T> keeps the proxy and therefore the vector alive
+      Memory<double> samples = new Image(4).samples();
+      for (int i = 0; i < 3; i++) {
+        GC.Collect();
+        GC.WaitForPendingFinalizers();
+      }
+      if (samples.Span[3] != 1.5)
+        throw new Exception("samples not kept alive");
+    }
+
+    if (csharp_lib_arrays_span.globalSamples().Length != 0)
+      throw new Exception("globalSamples wrong");
+  }
+
+  static void CompareArrays(int[] a, int[] b)
+  {
+    if (a.Length != b.Length)
+      throw new Exception("size mismatch");
+
+    for (int i = 0; i < a.Length; i++) {
+      if (a[i] != b[i])
+        throw new Exception("element mismatch");
+    }
+  }
+}
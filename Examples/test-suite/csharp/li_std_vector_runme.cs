@@ -188,6 +188,49 @@ public class li_std_vector_runme {
       }
       if (dvArray.Length != doubleArray.Length)
         throw new Exception("ToArray lengths mismatch");
+
+      // AddArray() and SetArray() test
+      DoubleVector dvBulk = new DoubleVector();
+      dvBulk.AddArray(doubleArray);
+      dvBulk.AddArray(new double[] { 66.6 });
+      if (dvBulk.Count != doubleArray.Length + 1 || dvBulk[0] != 0.0 || dvBulk[6] != 33.3 || dvBulk[7] != 66.6)
+        throw new Exception("AddArray test failed");
+      dvBulk.SetArray(6, new double[] { 77.7, 88.8 });
+      if (dvBulk.Count != doubleArray.Length + 1 || dvBulk[5] != 55.5 || dvBulk[6] != 77.7 || dvBulk[7] != 88.8)
+        throw new Exception("SetArray test failed");
+      try {
+        dvBulk.SetArray(7, new double[] { 77.7, 88.8 });
+        throw new Exception("SetArray too large test failed");
+      } catch (ArgumentOutOfRangeException) {
+      }
+      try {
+        dvBulk.AddArray(null);
+        throw new Exception("AddArray null test failed");
+      } catch (ArgumentNullException) {
+      }
+
+      // Bulk copies where the C and C# types differ in size
+      LongVector lv = new LongVector(new int[] { -1, 2, int.MaxValue });
+      int[] lvArray = lv.ToArray();
+      if (lv.Count != 3 || lvArray[0] != -1 || lvArray[1] != 2 || lvArray[2] != int.MaxValue)
+        throw new Exception("LongVector bulk copy test failed");
+      lv = new LongVector(new System.Collections.Generic.List<int>(lvArray));
+      if (lv.Count != 3 || lv[0] != -1 || lv[2] != int.MaxValue)
+        throw new Exception("LongVector ICollection constructor test failed");
+
+      // char is not blittable and is copied an element at a time, a non-ASCII
+      // character is converted via the ANSI code page but must not affect its neighbours
+      CharVector cv = new CharVector(new char[] { 'a', '\u00e9', 'c', 'd' });
+      char nonAscii = cv[1];
+      if (cv.Count != 4 || cv[0] != 'a' || cv[2] != 'c' || cv[3] != 'd')
+        throw new Exception("CharVector constructor test failed");
+      char[] cvArray = cv.ToArray();
+      if (cvArray.Length != 4 || cvArray[0] != 'a' || cvArray[1] != nonAscii || cvArray[2] != 'c' || cvArray[3] != 'd')
+        throw new Exception("CharVector ToArray test failed");
+      char[] cvPartial = new char[] { 'x', 'x', 'x', 'x', 'x' };
+      cv.CopyTo(1, cvPartial, 2, 2);
+      if (new string(cvPartial) != "xx" + nonAscii + "cx")
+        throw new Exception("CharVector partial CopyTo test failed");
     }
     {
       // Repeat() test
@@ -0,0 +1,61 @@
+%module(directors="1") csharp_fastpinvoke
+
+// Tests the blittable intermediary class signatures generated by -fastpinvoke
+
+%exception {
+  try {
+    $action
+  } catch (int code) {
+    SWIG_CSharpSetPendingException(SWIG_CSharpApplicationException, "int exception thrown");
+    return $null;
+  }
+}
+
+%cssuppressgctransition add;
+%cssuppressgctransition negate;
+
+// Ignored as returning a string calls back into C# to create the string
+%warnfilter(SWIGWARN_CSHARP_SUPPRESSGCTRANSITION) greeting;
+%cssuppressgctransition greeting;
+
+%warnfilter(SWIGWARN_TYPEMAP_CHARLEAK_MSG) global_name;  // Setting a const char * variable may leak memory.
+%warnfilter(SWIGWARN_TYPEMAP_CHARLEAK_MSG) Named::name;
+
+%feature("director") Callback;
+
+%inline %{
+#include <string.h>
+
+#if __cplusplus >= 201103L
+#define NOEXCEPT noexcept
+#else
+#define NOEXCEPT throw()
+#endif
+
+double add(double a, double b) NOEXCEPT { return a + b; }
+bool negate(bool b) NOEXCEPT { return !b; }
+bool is_positive(const bool &b, int i) { return b && i > 0; }
+int thrower(int code) { if (code) throw code; return 0; }
+
+size_t length(const char *str) { return str ? strlen(str) : (size_t)-1; }
+bool equals(const char *a, const char *b) { return a && b && strcmp(a, b) == 0; }
+const char *echo(const char *str) { return str; }
+const char *greeting() NOEXCEPT { return "h\xc3\xa9llo"; }
+const char *global_name = 0;
+
+struct Named {
+  Named(const char *name) : length(strlen(name)), flag(false), name(0) {}
+  size_t length;
+  bool flag;
+  const char *name;
+};
+
+struct Callback {
+  virtual ~Callback() {}
+  virtual bool check(bool b) { return b; }
+};
+
+struct CallbackHolder {
+  static bool check(Callback *c, bool b) { return c->check(b); }
+};
+%}
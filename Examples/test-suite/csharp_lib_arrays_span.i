@@ -0,0 +1,63 @@
+%module csharp_lib_arrays_span
+
+%include "std_vector.i"
+%include "arrays_span.i"
+
+%apply (const int *SPAN, size_t LENGTH) { (const int *source, size_t nsource) }
+%apply (int *SPAN, size_t LENGTH) { (int *target, size_t ntarget) }
+%apply (double *SPAN, size_t LENGTH) { (double *values, size_t nvalues) }
+
+%inline %{
+#include <vector>
+
+/* copy as many elements as fit from the first array to the second */
+size_t arrayCopy(const int *source, size_t nsource, int *target, size_t ntarget) {
+  size_t i;
+  for (i = 0; i < nsource && i < ntarget; i++)
+    target[i] = source[i];
+  return i;
+}
+
+int arraySum(const int *source, size_t nsource) {
+  int sum = 0;
+  for (size_t i = 0; i < nsource; i++)
+    sum += source[i];
+  return sum;
+}
+
+void arrayScale(double *values, size_t nvalues, double factor) {
+  for (size_t i = 0; i < nvalues; i++)
+    values[i] *= factor;
+}
+%}
+
+%apply std::vector<unsigned char> &SPAN { std::vector<unsigned char> &pixels }
+%apply const std::vector<unsigned char> &SPAN { const std::vector<unsigned char> &constPixels }
+%apply std::vector<double> &MEMORY { std::vector<double> &samples }
+%apply const std::vector<double> &MEMORY { const std::vector<double> &constSamples }
+%apply std::vector<double> &SPAN { std::vector<double> &globalSamples }
+
+%inline %{
+struct Image {
+  std::vector<unsigned char> data;
+  std::vector<double> values;
+
+  Image(size_t n) : data(n), values(n) {
+    for (size_t i = 0; i < n; i++) {
+      data[i] = (unsigned char)i;
+      values[i] = i * 0.5;
+    }
+  }
+  std::vector<unsigned char> &pixels() { return data; }
+  const std::vector<unsigned char> &constPixels() const { return data; }
+  std::vector<double> &samples() { return values; }
+  const std::vector<double> &constSamples() const { return values; }
+  unsigned char pixel(size_t i) const { return data[i]; }
+  double sample(size_t i) const { return values[i]; }
+};
+
+std::vector<double> &globalSamples() {
+  static std::vector<double> empty;
+  return empty;
+}
+%}
@@ -0,0 +1,15 @@
+%module xxx
+
+/* Options prefixed by a target language option are only used by that language */
+
+#if defined(SWIGPYTHON) && (!defined(PYTHON_ONLY) || defined(JAVA_ONLY))
+#error "Python options not scoped"
+#endif
+
+#if defined(SWIGJAVA) && (!defined(JAVA_ONLY) || defined(PYTHON_ONLY))
+#error "Java options not scoped"
+#endif
+
+#ifdef SWIGPYTHON
+#warning Python options scoped
+#endif
@@ -0,0 +1,47 @@
+
+import java_director_thread_detach.*;
+
+public class java_director_thread_detach_runme {
+
+  static {
+    try {
+      System.loadLibrary("java_director_thread_detach");
+    } catch (UnsatisfiedLinkError e) {
+      System.err.println("Native code library failed to load. See the chapter on Dynamic Linking Problems in the SWIG Java documentation for help.\n" + e);
+      System.exit(1);
+    }
+  }
+
+  public static void main(String argv[]) {
+    java_director_thread_detach_Recorder recorder = new java_director_thread_detach_Recorder();
+    java_director_thread_detach.upcall_from_native_thread(recorder, 10);
+
+    if (recorder.count != 10)
+      throw new RuntimeException("Wrong number of upcalls: " + recorder.count);
+    if (recorder.thread == null || recorder.thread == Thread.currentThread())
+      throw new RuntimeException("Upcalls not made from the native thread");
+
+    // A thread detached and attached again between upcalls is a different Java thread
+    if (!recorder.sameThread)
+      throw new RuntimeException("Native thread not kept attached across upcalls");
+
+    // The native thread has exited and so must have been detached
+    if (recorder.thread.isAlive())
+      throw new RuntimeException("Native thread not detached when it exited");
+  }
+}
+
+class java_director_thread_detach_Recorder extends Upcall {
+  int count = 0;
+  Thread thread = null;
+  boolean sameThread = true;
+
+  public void upcall() {
+    Thread current = Thread.currentThread();
+    if (thread == null)
+      thread = current;
+    else if (thread != current)
+      sameThread = false;
+    count++;
+  }
+}
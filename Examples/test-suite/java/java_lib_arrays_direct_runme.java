@@ -0,0 +1,52 @@
+import java_lib_arrays_direct.*;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.DoubleBuffer;
+import java.nio.IntBuffer;
+
+public class java_lib_arrays_direct_runme {
+
+  static {
+    try {
+	System.loadLibrary("java_lib_arrays_direct");
+    } catch (UnsatisfiedLinkError e) {
+      System.err.println("Native code library failed to load. See the chapter on Dynamic Linking Problems in the SWIG Java documentation for help.\n" + e);
+      System.exit(1);
+    }
+  }
+
+  public static void main(String argv[]) throws Throwable
+  {
+    // Critical arrays
+    double[] values = new double[] {1.5, 2.5, 3.5};
+    check(java_lib_arrays_direct.first(values), 1.5);
+    java_lib_arrays_direct.scale(values, 2.0);
+    check(values[0], 3.0);
+    check(values[2], 7.0);
+    check(java_lib_arrays_direct.sum_ints(new int[] {1, 2, 3, 4}, 4), 10);
+    check(java_lib_arrays_direct.count_bytes(new byte[] {1, 2, (byte)255}), 258);
+
+    try {
+      java_lib_arrays_direct.scale(null, 2.0);
+      throw new RuntimeException("NullPointerException not thrown");
+    } catch (NullPointerException e) {
+    }
+
+    // Direct buffers
+    DoubleBuffer buffer = ByteBuffer.allocateDirect(4*8).order(ByteOrder.nativeOrder()).asDoubleBuffer();
+    java_lib_arrays_direct.fill_buffer(buffer, 4, 0.5);
+    check(buffer.get(3), 0.5);
+    java_lib_arrays_direct.scale_buffer(buffer, 4.0);
+    check(buffer.get(0), 2.0);
+    check(buffer.get(3), 2.0);
+
+    IntBuffer ints = ByteBuffer.allocateDirect(3*4).order(ByteOrder.nativeOrder()).asIntBuffer();
+    ints.put(0, 1).put(1, 2).put(2, 3);
+    check(java_lib_arrays_direct.sum_int_buffer(ints), 6);
+  }
+
+  private static void check(double got, double expected) {
+    if (got != expected)
+      throw new RuntimeException("got " + got + ", expected " + expected);
+  }
+}
@@ -167,5 +167,40 @@ public class li_std_vector_runme {
       throw new RuntimeException("v11 test (2) failed");
     } catch (IndexOutOfBoundsException e) {
     }
+
+    double[] a12 = {1.5, 2.5, 3.5, 4.5};
+    DoubleVector v12 = new DoubleVector(a12);
+    if (v12.size() != 4) throw new RuntimeException("v12 test (1) failed");
+    if (!java.util.Arrays.equals(v12.toPrimitiveArray(), a12)) throw new RuntimeException("v12 test (2) failed");
+    if (!java.util.Arrays.equals(v12.getRange(1, 3), new double[] {2.5, 3.5})) throw new RuntimeException("v12 test (3) failed");
+    double[] a12copy = new double[6];
+    v12.copyTo(a12copy, 2);
+    if (!java.util.Arrays.equals(a12copy, new double[] {0, 0, 1.5, 2.5, 3.5, 4.5})) throw new RuntimeException("v12 test (4) failed");
+    if (!v12.addAllArray(new double[] {5.5, 6.5})) throw new RuntimeException("v12 test (5) failed");
+    if (v12.size() != 6 || v12.get(5) != 6.5) throw new RuntimeException("v12 test (6) failed");
+    try {
+      // The Collection overload, which must not be ambiguous
+      v12.addAll(null);
+      throw new RuntimeException("v12 addAll(null) test failed");
+    } catch (NullPointerException e) {
+    }
+    v12.setRange(4, new double[] {7.5, 8.5});
+    if (v12.get(3) != 4.5 || v12.get(4) != 7.5 || v12.get(5) != 8.5) throw new RuntimeException("v12 test (7) failed");
+    try {
+      v12.copyTo(a12copy, 1);
+      throw new RuntimeException("v12 test (8) failed");
+    } catch (IndexOutOfBoundsException e) {
+    }
+    try {
+      v12.setRange(5, new double[] {1, 2});
+      throw new RuntimeException("v12 test (9) failed");
+    } catch (IndexOutOfBoundsException e) {
+    }
+    if (!new DoubleVector(v12).equals(v12)) throw new RuntimeException("v12 test (10) failed");
+    if (!new DoubleVector(java.util.Arrays.asList(1.5, 2.5)).equals(java.util.Arrays.asList(1.5, 2.5))) throw new RuntimeException("v12 test (11) failed");
+
+    UIntVector v13 = new UIntVector(new long[] {1, 4000000000L});
+    if (v13.get(1) != 4000000000L) throw new RuntimeException("v13 test (1) failed");
+    if (v13.toPrimitiveArray()[1] != 4000000000L) throw new RuntimeException("v13 test (2) failed");
   }
 }
@@ -0,0 +1,44 @@
+%module(directors="1") java_director_thread_detach
+
+// Native threads stay attached to the JVM across upcalls and are detached when they exit
+
+%begin %{
+#define SWIG_JAVA_DETACH_ON_THREAD_END
+%}
+
+%{
+#include <pthread.h>
+%}
+
+%feature("director") Upcall;
+
+%inline %{
+struct Upcall {
+  virtual ~Upcall() {}
+  virtual void upcall() {}
+};
+%}
+
+%{
+struct UpcallLoop {
+  Upcall *upcall;
+  int count;
+};
+
+extern "C" void *upcall_loop(void *data) {
+  UpcallLoop *loop = static_cast<UpcallLoop *>(data);
+  for (int i = 0; i < loop->count; i++)
+    loop->upcall->upcall();
+  return 0;
+}
+%}
+
+%inline %{
+// Makes count upcalls from a new native thread and waits for the thread to exit
+void upcall_from_native_thread(Upcall *upcall, int count) {
+  UpcallLoop loop = { upcall, count };
+  pthread_t thread;
+  if (pthread_create(&thread, NULL, upcall_loop, &loop) == 0)
+    pthread_join(thread, NULL);
+}
+%}
@@ -0,0 +1,61 @@
+/* Testcase for the Java critical array and direct buffer typemaps */
+%module java_lib_arrays_direct
+
+%include "arrays_direct.i"
+
+%apply double *CRITICAL { double *values };
+%apply (double *CRITICAL, size_t LENGTH) { (double *data, size_t n) };
+%apply int CRITICAL[] { int ints[] };
+%apply (unsigned char *CRITICAL, size_t LENGTH) { (unsigned char *bytes, size_t nbytes) };
+%apply double *DIRECTBUFFER { double *buffer };
+%apply (double *DIRECTBUFFER, size_t LENGTH) { (double *bufdata, size_t bufsize) };
+%apply (int *DIRECTBUFFER, size_t LENGTH) { (int *intdata, size_t intsize) };
+
+%inline %{
+#include <stddef.h>
+
+double first(double *values) {
+  return values[0];
+}
+
+void scale(double *data, size_t n, double factor) {
+  size_t i;
+  for (i = 0; i < n; ++i)
+    data[i] *= factor;
+}
+
+int sum_ints(int ints[], int n) {
+  int i, sum = 0;
+  for (i = 0; i < n; ++i)
+    sum += ints[i];
+  return sum;
+}
+
+int count_bytes(unsigned char *bytes, size_t nbytes) {
+  size_t i;
+  int count = 0;
+  for (i = 0; i < nbytes; ++i)
+    count += bytes[i];
+  return count;
+}
+
+void fill_buffer(double *buffer, int n, double value) {
+  int i;
+  for (i = 0; i < n; ++i)
+    buffer[i] = value;
+}
+
+void scale_buffer(double *bufdata, size_t bufsize, double factor) {
+  size_t i;
+  for (i = 0; i < bufsize; ++i)
+    bufdata[i] *= factor;
+}
+
+int sum_int_buffer(int *intdata, size_t intsize) {
+  size_t i;
+  int sum = 0;
+  for (i = 0; i < intsize; ++i)
+    sum += intdata[i];
+  return sum;
+}
+%}
@@ -0,0 +1,55 @@
+#!/usr/bin/perl
+
+use strict;
+
+my $nmodules = 60; #adjust these to time the import of more or bigger modules
+my $modsize = 100;
+
+my $runme = shift @ARGV;
+
+open HEADER, ">importtime.h" or die "error";
+open TEST, ">$runme" or die "error";
+open I0, ">importtime_base.i" or die "error";
+open MODULES, ">importtime_modules.list" or die "error";
+
+print TEST "import time\n";
+print TEST "start = time.time()\n";
+print TEST "import importtime_base\n";
+
+print I0 "\%module importtime_base;\n";
+print I0 "\%include \"importtime.h\";\n";
+print I0 "\%{ #include \"importtime.h\" \%}\n";
+
+my $i;
+my $m;
+
+for ($i = 0; $i < $modsize; $i++) {
+  print HEADER "class type$i { public: int a; };\n";
+}
+
+for ($m = 0; $m < $nmodules; $m++) {
+  open I, ">importtime_$m.i" or die "error";
+  print I "\%module importtime_$m;\n";
+  print I "\%import(module=\"importtime_base\") \"importtime.h\";\n";
+  print I "\%{ #include \"importtime.h\" \%}\n";
+  print I "\%inline \%{\n";
+  for ($i = 0; $i < $modsize; $i++) {
+    print I "class dtype${m}_$i : public type$i { public: int b; };\n";
+  }
+  print I "\%}\n";
+  close I;
+
+  print MODULES "importtime_$m\n";
+  print TEST "import importtime_$m\n";
+}
+
+print TEST "print(\"imported $nmodules modules in %.3f seconds\" % (time.time() - start))\n";
+print TEST "c = importtime_", $nmodules - 1, ".dtype", $nmodules - 1, "_0()\n";
+print TEST "c.a = 4\n";
+print TEST "if c.a != 4:\n";
+print TEST "    raise RuntimeError\n";
+
+close HEADER;
+close TEST;
+close I0;
+close MODULES;
@@ -0,0 +1,17 @@
+from python_autothreads import *
+
+def check(got, expected):
+    if got != expected:
+        raise RuntimeError("got %r, expected %r" % (got, expected))
+
+c = Counter()
+c.count = 3
+check(c.count, 3)
+c.set(4)
+check(c.get(), 4)
+
+# the GIL is released except around accessors and trivialcall functions
+check(c.held_member(), False)
+check(held_trivialcall(), True)
+check(held_default(), False)
+check(released_forced(), False)
@@ -0,0 +1,58 @@
+from python_cachedispatch import *
+
+def check(got, expected):
+    if got != expected:
+        raise RuntimeError("got %r, expected %r" % (got, expected))
+
+def check_error(exception, func, *args):
+    try:
+        func(*args)
+    except exception:
+        return
+    raise RuntimeError("%s not raised" % exception.__name__)
+
+b = Base()
+d = Derived()
+o = Other()
+
+class PyDerived(Derived):
+    pass
+
+p = PyDerived()
+
+# repeat the calls so that they are answered from the dispatch cache
+for i in range(3):
+    check(visit(b), 1)
+    check(visit(d), 1)
+    check(visit(p), 1)
+    check(visit(o), 2)
+    check(visit(None), 1)
+    check(visit(b, o), 3)
+    check(visit(o, b), 4)
+    check(visit(o, d), 4)
+    check(visit(d, d), 5)
+    check(visit(d, o), 3)
+    check(visit(p, d), 5)
+    check(visit(None, None), 5)
+    check_error(NotImplementedError, visit, 1)
+    check_error(NotImplementedError, visit, "b")
+    check_error(NotImplementedError, visit, b, b)
+    check_error(NotImplementedError, visit, b, [])
+
+    check(refs(b), 1)
+    check(refs(d), 1)
+    check(refs(o), 2)
+    check_error(Exception, refs, 1)
+
+    check(mixed(b), 1)
+    check(mixed(1), 2)
+    check(mixed(1.5), 3)
+    check(mixed(None), 1)
+    check_error(NotImplementedError, mixed, "b")
+
+    v = Visitor()
+    check(v.visit(b), 11)
+    check(v.visit(o), 13)
+    check(v.visit(o, b), 14)
+    check(v.visit(o, None), 13)
+    check_error(NotImplementedError, v.visit, b, b)
@@ -0,0 +1,46 @@
+from python_convertonce import *
+
+def check(got, expected):
+    if got != expected:
+        raise RuntimeError("got %r, expected %r" % (got, expected))
+
+def check_error(exception, func, *args):
+    try:
+        func(*args)
+    except exception:
+        return
+    raise RuntimeError("%s not raised" % exception.__name__)
+
+b = Base(1)
+d = Derived(2)
+o = Other(3)
+
+class PyDerived(Derived):
+    pass
+
+p = PyDerived(4)
+
+for i in range(3):
+    check(pick(b), 1)
+    check(pick(d), 2)
+    check(pick(p), 4)
+    check(pick(o), 103)
+    check(pick(None), -1)
+    check(pick(b, o), 13)
+    check(pick(p, o), 43)
+    check(pick(o, d), 320)
+    check(pick(o, b, p), 314)
+    check(pick(o, b, None), 310)
+    check_error(NotImplementedError, pick, b, b)
+    check_error(NotImplementedError, pick, 1)
+
+    check(mixed(b, 5), 6)
+    check(mixed(o, 5), 108)
+    check_error(NotImplementedError, mixed, b, "5")
+
+    check(take(o), 103)
+    check(take(Derived(7)), 7)
+
+# conversions after a failed dispatch are not affected
+check_error(NotImplementedError, pick, o, o)
+check(pick(d), 2)
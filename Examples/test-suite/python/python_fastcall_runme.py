@@ -0,0 +1,46 @@
+from python_fastcall import *
+
+def check(got, expected):
+    if got != expected:
+        raise RuntimeError("got %r, expected %r" % (got, expected))
+
+def check_error(exception, func, *args, **kwargs):
+    try:
+        func(*args, **kwargs)
+    except exception:
+        return
+    raise RuntimeError("%s not raised" % exception.__name__)
+
+check(none(), 0)
+check(one(1), 1)
+check(three(1, 2, 3), 321)
+check_error(TypeError, three, 1, 2)
+check_error(TypeError, three, 1, 2, 3, 4)
+
+check(defaults(1), 321)
+check(defaults(1, 4), 341)
+check(defaults(1, 4, 5), 541)
+
+# keyword arguments
+check(kw(1), 321)
+check(kw(1, c=5), 521)
+check(kw(c=5, b=4, a=1), 541)
+check(kw(1, **{"b": 4}), 341)
+check_error(TypeError, kw, b=4)
+check_error(TypeError, kw, 1, a=1)
+check_error(TypeError, kw, 1, d=1)
+check_error(TypeError, kw, 1, 2, 3, 4)
+
+# overloads
+check(over(1), 1)
+check(over(1, 2), 2)
+check(over("s"), 3)
+check_error(NotImplementedError, over, 1, 2, 3)
+
+k = Klass(10)
+check(k.add(1, 2), 13)
+check(k.kwmethod(2), 20)
+check(k.kwmethod(b=3, a=2), 16)
+check(k.over(1), 11)
+check(k.over(1, 2), 13)
+check_error(NotImplementedError, k.over, 1, 2, 3)
@@ -0,0 +1,5 @@
+from python_runtime_threads import *
+
+failures = stress(8, 20000)
+if failures != 0:
+    raise RuntimeError("%d type system checks failed" % failures)
@@ -0,0 +1,38 @@
+import weakref
+from python_slotthis import *
+
+def check(got, expected):
+    if got != expected:
+        raise RuntimeError("got %r, expected %r" % (got, expected))
+
+if "SwigPyProxy" not in [c.__name__ for c in Derived.__mro__]:
+    raise RuntimeError("proxy classes do not use the SwigPyProxy base")
+
+d = Derived(3)
+check(get_value(d), 3)
+check(d.thisown, True)
+d.value = 4
+check(d.get(), 4)
+
+# returned objects
+r = make_derived(5)
+check(get_value(r), 5)
+check(r.thisown, True)
+
+# multiple inheritance
+b = Both(6)
+check(get_value(b), 6)
+check(b.other(), 42)
+
+# python subclasses with their own attributes
+class PyDerived(Derived):
+    def __init__(self, value):
+        Derived.__init__(self, value)
+        self.extra = "extra"
+
+p = PyDerived(7)
+check(get_value(p), 7)
+check(p.extra, "extra")
+
+w = weakref.ref(p)
+check(w() is p, True)
@@ -0,0 +1,19 @@
+from python_typequery import *
+
+def check(name, expected):
+    got = type_query(name)
+    if got != expected:
+        raise RuntimeError("type_query(%r) returned %r, expected %r" % (name, got, expected))
+
+# mangled names
+check("_p_Foo", "_p_Foo")
+check("_p_Space__Baz", "_p_Space__Baz")
+
+# human readable names, ignoring spaces and including typedef aliases
+for i in range(2):
+    check("Foo *", "_p_Foo")
+    check("Foo*", "_p_Foo")
+    check("Bar *", "_p_Foo")
+    check("Space::Baz *", "_p_Space__Baz")
+    check("Space :: Baz*", "_p_Space__Baz")
+    check("Nothing *", None)
@@ -0,0 +1,42 @@
+import array
+import sys
+from python_vector_buffer import *
+
+def check(got, expected):
+    if got != expected:
+        raise RuntimeError("got %r, expected %r" % (got, expected))
+
+# sequences still work
+check(sum([1.0, 2.0, 3.5]), 6.5)
+check(isum((1, 2, 3)), 6)
+
+# objects exporting a buffer
+check(sum(array.array("d", [1.0, 2.0, 3.5])), 6.5)
+check(isum(array.array("i", [1, 2, 3])), 6)
+check(bytes_size(b"abcd"), 4)
+check(sum(array.array("d")), 0.0)
+
+# element types that do not match are converted one by one
+check(sum(array.array("i", [1, 2])), 3.0)
+try:
+    isum(array.array("d", [1.5]))
+    raise RuntimeError("float buffer converted to std::vector<int>")
+except TypeError:
+    pass
+
+check(overloaded(1), 1)
+check(overloaded(array.array("d", [1.0])), 2)
+
+if sys.version_info[0:2] >= (3, 3):
+    check(sum(memoryview(array.array("d", [1.0, 2.0, 4.0, 8.0]))[::2]), 5.0)
+
+    r = ramp(4)
+    check(isinstance(r, memoryview), True)
+    check(r.format, "d")
+    check(r.tolist(), [0.0, 0.5, 1.0, 1.5])
+    check(sum(r), 3.0)
+    check(iramp(3).tolist(), [0, -1, -2])
+    check(len(ramp(0)), 0)
+    check(flags(), (True, False))
+else:
+    check(list(ramp(4)), [0.0, 0.5, 1.0, 1.5])
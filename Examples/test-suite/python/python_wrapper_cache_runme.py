@@ -0,0 +1,40 @@
+from python_wrapper_cache import *
+
+def check(got, expected):
+    if got != expected:
+        raise RuntimeError("got %r, expected %r" % (got, expected))
+
+n = Node(1)
+n.set_child(2)
+
+# many short lived wrappers, reusing the pooled objects
+total = 0
+for i in range(10000):
+    total += n.get_child().value + n.clone().value
+check(total, 30000)
+
+c = n.get_child()
+check(c.value, 2)
+
+if not is_python_builtin():
+    # non-owning wrappers are shared while they are alive
+    check(n.get_child() is c, True)
+    check(n.itself() is n, False)
+    s = n.itself()
+    check(n.itself() is s, True)
+
+    # owning wrappers are never shared
+    k1 = n.clone()
+    k2 = n.clone()
+    check(k1 is k2, False)
+
+    # nor wrappers whose ownership was changed
+    c.thisown = 1
+    d = n.get_child()
+    check(d is c, False)
+    c.thisown = 0
+    del c, d
+
+# a different object
+n.set_child(3)
+check(n.get_child().value, 3)
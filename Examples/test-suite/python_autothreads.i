@@ -0,0 +1,29 @@
+%module python_autothreads
+
+// Wrappers generated with -autothreads, see the Makefile
+
+%feature("trivialcall") held_trivialcall;
+%feature("trivialcall") released_forced;
+%feature("nothreadallow", "0") released_forced;
+
+%{
+#if PY_VERSION_HEX >= 0x03040000
+#define GIL_HELD(EXPECTED) (PyGILState_Check() != 0)
+#else
+#define GIL_HELD(EXPECTED) EXPECTED
+#endif
+%}
+
+%inline %{
+struct Counter {
+  int count;
+  Counter() : count(0) {}
+  int get() const { return count; }
+  void set(int c) { count = c; }
+  bool held_member() const { return GIL_HELD(false); }
+};
+
+bool held_trivialcall() { return GIL_HELD(true); }
+bool held_default() { return GIL_HELD(false); }
+bool released_forced() { return GIL_HELD(false); }
+%}
@@ -0,0 +1,27 @@
+%module python_cachedispatch
+
+// Dispatch functions generated with -cachedispatch, see the Makefile
+
+%inline %{
+struct Base { virtual ~Base() {} };
+struct Derived : Base {};
+struct Other {};
+
+int visit(Base *b) { return 1; }
+int visit(Other *o) { return 2; }
+int visit(Base *b, Other *o) { return 3; }
+int visit(Other *o, Base *b) { return 4; }
+int visit(Derived *d, Derived *e) { return 5; }
+
+int refs(const Base &b) { return 1; }
+int refs(const Other &o) { return 2; }
+
+int mixed(Base *b) { return 1; }
+int mixed(int i) { return 2; }
+int mixed(double d) { return 3; }
+
+struct Visitor {
+  int visit(Base *b) const { return 11; }
+  int visit(Other *o, Base *b = 0) const { return b ? 14 : 13; }
+};
+%}
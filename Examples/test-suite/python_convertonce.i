@@ -0,0 +1,31 @@
+%module python_convertonce
+
+// Dispatch functions generated with -convertonce, see the Makefile
+
+%apply SWIGTYPE *DISOWN { Base *owned };
+
+%inline %{
+struct Base {
+  int id;
+  Base(int id = 0) : id(id) {}
+  virtual ~Base() {}
+};
+struct Derived : Base {
+  Derived(int id = 0) : Base(id) {}
+};
+struct Other {
+  int id;
+  Other(int id = 0) : id(id) {}
+};
+
+int pick(Base *b) { return b ? b->id : -1; }
+int pick(Other *o) { return o ? 100 + o->id : -1; }
+int pick(Base *b, Other *o) { return 10*b->id + o->id; }
+int pick(Other *o, const Base &b, Base *c = 0) { return 100*o->id + 10*b.id + (c ? c->id : 0); }
+
+int mixed(Base *b, int i) { return b->id + i; }
+int mixed(Other *o, int i) { return 100 + o->id + i; }
+
+int take(Base *owned) { int id = owned->id; delete owned; return id; }
+int take(Other *o) { return 100 + o->id; }
+%}
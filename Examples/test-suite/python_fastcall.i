@@ -0,0 +1,27 @@
+%module python_fastcall
+
+// Wrappers generated with -fastcall, see the Makefile
+
+%feature("kwargs") kw;
+%feature("kwargs") Klass::kwmethod;
+
+%inline %{
+int none() { return 0; }
+int one(int a) { return a; }
+int three(int a, int b, int c) { return a + 10*b + 100*c; }
+int defaults(int a, int b = 2, int c = 3) { return a + 10*b + 100*c; }
+int kw(int a, int b = 2, int c = 3) { return a + 10*b + 100*c; }
+
+int over(int a) { return 1; }
+int over(int a, int b) { return 2; }
+int over(const char *s) { return 3; }
+
+struct Klass {
+  int value;
+  Klass(int value = 0) : value(value) {}
+  int add(int a, int b) const { return value + a + b; }
+  int kwmethod(int a, int b = 5) const { return value + a*b; }
+  int over(int a) const { return value + a; }
+  int over(int a, int b) const { return value + a + b; }
+};
+%}
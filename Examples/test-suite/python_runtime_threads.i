@@ -0,0 +1,115 @@
+%module python_runtime_threads
+
+// Stress test using the runtime type system from several threads at once
+
+%{
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+#else
+#include <pthread.h>
+#endif
+%}
+
+%inline %{
+struct Base {
+  int b;
+  virtual ~Base() {}
+};
+struct Middle : Base {
+  int m;
+};
+struct Derived : Middle {
+  int d;
+};
+struct Other : Base {
+  int o;
+};
+
+void take(Base *, Middle *, Derived *, Other *) {}
+%}
+
+%{
+struct StressData {
+  swig_module_info *module;
+  int iterations;
+  int failures;
+};
+
+static void stress_loop(StressData *data) {
+  swig_module_info *module = data->module;
+  int i;
+  for (i = 0; i < data->iterations; ++i) {
+    Derived d;
+    int newmemory = 0;
+    /* Searching from another module in the list replaces the index of the names */
+    swig_module_info *start = (i & 2) ? module->next : module;
+    swig_type_info *base = SWIG_TypeQueryModule(start, start, "Base *");
+    swig_type_info *middle = SWIG_TypeQueryModule(start, start, "Middle *");
+    swig_type_info *derived = SWIG_TypeQueryModule(start, start, (i & 1) ? "Derived *" : "_p_Derived");
+    swig_cast_info *cast;
+    if (!base || !middle || !derived) {
+      ++data->failures;
+      continue;
+    }
+    cast = SWIG_TypeCheckStruct(derived, base);
+    if (!cast || SWIG_TypeCast(cast, &d, &newmemory) != static_cast<Base *>(&d))
+      ++data->failures;
+    cast = SWIG_TypeCheck("_p_Derived", middle);
+    if (!cast || SWIG_TypeCast(cast, &d, &newmemory) != static_cast<Middle *>(&d))
+      ++data->failures;
+    if (SWIG_TypeCheck("_p_Other", middle) || SWIG_TypeCheckStruct(base, derived))
+      ++data->failures;
+  }
+}
+
+extern "C" {
+#ifdef _WIN32
+  static unsigned int __stdcall stress_thread(void *data) {
+    stress_loop((StressData *)data);
+    return 0;
+  }
+#else
+  static void *stress_thread(void *data) {
+    stress_loop((StressData *)data);
+    return 0;
+  }
+#endif
+}
+%}
+
+%inline %{
+// Returns the number of failed checks
+int stress(int nthreads, int iterations) {
+  StressData data[16];
+  int failures = 0;
+  int i;
+#ifdef _WIN32
+  HANDLE threads[16];
+#else
+  pthread_t threads[16];
+#endif
+  if (nthreads > 16)
+    nthreads = 16;
+  for (i = 0; i < nthreads; ++i) {
+    data[i].module = SWIG_GetModule(0);
+    data[i].iterations = iterations;
+    data[i].failures = 0;
+#ifdef _WIN32
+    threads[i] = (HANDLE)_beginthreadex(NULL, 0, stress_thread, &data[i], 0, NULL);
+#else
+    pthread_create(&threads[i], NULL, stress_thread, &data[i]);
+#endif
+  }
+  for (i = 0; i < nthreads; ++i) {
+#ifdef _WIN32
+    WaitForSingleObject(threads[i], INFINITE);
+    CloseHandle(threads[i]);
+#else
+    pthread_join(threads[i], NULL);
+#endif
+    failures += data[i].failures;
+  }
+  return failures;
+}
+%}
@@ -0,0 +1,29 @@
+%module python_slotthis
+
+// Proxy classes generated with -slotthis, see the Makefile
+
+%newobject make_derived;
+
+%inline %{
+struct Base {
+  int value;
+  Base(int value = 0) : value(value) {}
+  virtual ~Base() {}
+  int get() const { return value; }
+};
+
+struct Derived : Base {
+  Derived(int value = 0) : Base(value) {}
+};
+
+struct Other {
+  int other() const { return 42; }
+};
+
+struct Both : Derived, Other {
+  Both(int value = 0) : Derived(value) {}
+};
+
+int get_value(const Base *b) { return b->get(); }
+Base *make_derived(int value) { return new Derived(value); }
+%}
@@ -0,0 +1,17 @@
+%module python_typequery
+
+%inline %{
+struct Foo {};
+typedef Foo Bar;
+namespace Space {
+  struct Baz {};
+}
+
+void take(Foo *, Bar *, Space::Baz *) {}
+
+const char *type_query(const char *name) {
+  swig_module_info *module = SWIG_GetModule(0);
+  swig_type_info *ty = SWIG_TypeQueryModule(module, module, name);
+  return ty ? ty->name : 0;
+}
+%}
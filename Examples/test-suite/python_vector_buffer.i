@@ -0,0 +1,58 @@
+%module python_vector_buffer
+
+%begin %{
+#define SWIG_PYTHON_VECTOR_BUFFER
+%}
+
+%include <std_vector.i>
+
+%template(DoubleVector) std::vector<double>;
+%template(IntVector) std::vector<int>;
+%template(UCharVector) std::vector<unsigned char>;
+%template(BoolVector) std::vector<bool>;
+
+%inline %{
+#include <vector>
+
+double sum(const std::vector<double> &v) {
+  double s = 0;
+  for (size_t i = 0; i < v.size(); ++i)
+    s += v[i];
+  return s;
+}
+
+int isum(std::vector<int> v) {
+  int s = 0;
+  for (size_t i = 0; i < v.size(); ++i)
+    s += v[i];
+  return s;
+}
+
+size_t bytes_size(const std::vector<unsigned char> &v) {
+  return v.size();
+}
+
+std::vector<double> ramp(int n) {
+  std::vector<double> v;
+  for (int i = 0; i < n; ++i)
+    v.push_back(i * 0.5);
+  return v;
+}
+
+std::vector<int> iramp(int n) {
+  std::vector<int> v;
+  for (int i = 0; i < n; ++i)
+    v.push_back(-i);
+  return v;
+}
+
+std::vector<bool> flags() {
+  std::vector<bool> v;
+  v.push_back(true);
+  v.push_back(false);
+  return v;
+}
+
+int overloaded(int) { return 1; }
+int overloaded(const std::vector<double> &) { return 2; }
+%}
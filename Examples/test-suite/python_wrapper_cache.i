@@ -0,0 +1,27 @@
+%module python_wrapper_cache
+
+%begin %{
+#define SWIG_PYTHON_FREELIST
+#define SWIG_PYTHON_WRAPPER_CACHE
+%}
+
+%newobject Node::clone;
+
+%inline %{
+struct Node {
+  int value;
+  Node *child;
+  Node(int value = 0) : value(value), child(0) {}
+  ~Node() { delete child; }
+  Node *get_child() { return child; }
+  Node &itself() { return *this; }
+  Node *clone() const { return new Node(value); }
+  void set_child(int v) { delete child; child = new Node(v); }
+};
+
+#ifdef SWIGPYTHON_BUILTIN
+bool is_python_builtin() { return true; }
+#else
+bool is_python_builtin() { return false; }
+#endif
+%}
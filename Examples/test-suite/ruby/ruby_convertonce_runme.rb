@@ -0,0 +1,52 @@
+#!/usr/bin/env ruby
+#
+# Overloaded methods dispatched with -convertonce
+#
+
+require 'swig_assert'
+
+require 'ruby_convertonce'
+
+include Ruby_convertonce
+
+def check_error(*args)
+  begin
+    pick(*args)
+  rescue ArgumentError
+    return
+  end
+  raise SwigRubyError.new("ArgumentError not raised for #{args.inspect}")
+end
+
+class RubyDerived < Derived
+end
+
+b = Base.new(1)
+d = Derived.new(2)
+o = Other.new(3)
+r = RubyDerived.new(4)
+
+3.times do
+  swig_assert_equal_simple(1, pick(b))
+  swig_assert_equal_simple(2, pick(d))
+  swig_assert_equal_simple(4, pick(r))
+  swig_assert_equal_simple(103, pick(o))
+  swig_assert_equal_simple(-1, pick(nil))
+  swig_assert_equal_simple(13, pick(b, o))
+  swig_assert_equal_simple(43, pick(r, o))
+  swig_assert_equal_simple(320, pick(o, d))
+  swig_assert_equal_simple(314, pick(o, b, r))
+  swig_assert_equal_simple(310, pick(o, b, nil))
+  check_error(b, b)
+  check_error(1)
+
+  swig_assert_equal_simple(6, mixed(b, 5))
+  swig_assert_equal_simple(108, mixed(o, 5))
+
+  swig_assert_equal_simple(103, take(o))
+  swig_assert_equal_simple(7, take(Derived.new(7)))
+end
+
+# conversions after a failed dispatch are not affected
+check_error(o, o)
+swig_assert_equal_simple(2, pick(d))
@@ -49,6 +49,10 @@
  *   %csmethodmodifiers myArrayCopy "public unsafe";
  *   void myArrayCopy( int *sourceArray, int* targetArray, int nitems );
  *
+ * See arrays_span.i for typemaps that also avoid copying but use Span<T> and
+ * Memory<T> in the public interface.  The generated methods do not need to be
+ * marked unsafe, but the code still uses unsafe blocks and must be compiled with
+ * the -unsafe option.
  * ----------------------------------------------------------------------------- */
 
 %define CSHARP_ARRAYS( CTYPE, CSTYPE )
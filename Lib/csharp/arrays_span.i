@@ -0,0 +1,165 @@
+/* -----------------------------------------------------------------------------
+ * arrays_span.i
+ *
+ * Typemaps mapping C arrays to System.Span<T> and System.Memory<T> so that
+ * numeric data crosses the managed-native boundary without being copied.  They
+ * require .NET Core 2.1 or later (or the System.Memory package) and the generated
+ * code must be compiled with the -unsafe C# compiler option.  The typemaps are
+ * not used by default, they are applied to the parameters and return values that
+ * need them.
+ *
+ * Input arrays
+ * ------------
+ * A (pointer, length) pair of parameters becomes a single Span<T> parameter, or
+ * ReadOnlySpan<T> if the pointer is const.  The memory behind the span, which
+ * may be a managed array, stackalloc memory or native memory, is pinned for the
+ * duration of the call and passed directly to C/C++:
+ *
+ *   %include "arrays_span.i"
+ *   %apply (const unsigned char *SPAN, size_t LENGTH) { (const unsigned char *src, size_t n) }
+ *   %apply (unsigned char *SPAN, size_t LENGTH) { (unsigned char *dst, size_t m) }
+ *   void invert(const unsigned char *src, size_t n, unsigned char *dst, size_t m);
+ *
+ *   byte[] image = ...;
+ *   byte[] result = new byte[image.Length];
+ *   example.invert(image, result);
+ *
+ * Returned vectors
+ * ----------------
+ * A std::vector returned by reference becomes a Span<T> (SPAN) or Memory<T>
+ * (MEMORY) over the vector's own storage, or ReadOnlySpan<T>/ReadOnlyMemory<T>
+ * for a const reference.  The typemaps match on the function name:
+ *
+ *   %apply std::vector<float> &SPAN { std::vector<float> &pixels }
+ *   %apply const std::vector<float> &MEMORY { const std::vector<float> &samples }
+ *   struct Image {
+ *     std::vector<float> &pixels();
+ *     const std::vector<float> &samples() const;
+ *   };
+ *
+ * The span or memory is only valid while the vector exists and is not resized.
+ * A Span<T> cannot keep the C# proxy alive, so the proxy must be kept reachable
+ * (for example with GC.KeepAlive) while the span is in use.  The MEMORY typemaps
+ * hold a reference to the proxy for as long as the Memory<T> is reachable, so the
+ * vector is not deleted by the garbage collector, but they can only be used for
+ * non-static member functions.  Neither protects against the proxy being
+ * disposed explicitly.
+ *
+ * long and unsigned long are not supported as their size differs between
+ * platforms.  bool is not supported as std::vector<bool> does not store its
+ * elements in an array.
+ * ----------------------------------------------------------------------------- */
+
+%{
+typedef struct {
+  void *data;
+  size_t size;
+} SWIG_CSharpSpan;
+%}
+
+%pragma(csharp) imclasscode=%{
+  [global::System.Runtime.InteropServices.StructLayout(global::System.Runtime.InteropServices.LayoutKind.Sequential)]
+  public struct SWIGSpan {
+    public global::System.IntPtr data;
+    public global::System.UIntPtr size;
+
+    public SWIGSpan(global::System.IntPtr data, int size) {
+      this.data = data;
+      this.size = (global::System.UIntPtr)(uint)size;
+    }
+
+    public unsafe global::System.Span<T> ToSpan<T>() where T : unmanaged {
+      return new global::System.Span<T>((void *)data, checked((int)size.ToUInt64()));
+    }
+  }
+
+  public sealed class SWIGMemoryManager<T> : global::System.Buffers.MemoryManager<T> where T : unmanaged {
+    private readonly object owner;
+    private readonly SWIGSpan span;
+
+    public SWIGMemoryManager(object owner, SWIGSpan span) {
+      this.owner = owner;
+      this.span = span;
+    }
+
+    public override global::System.Span<T> GetSpan() {
+      return span.ToSpan<T>();
+    }
+
+    public override unsafe global::System.Buffers.MemoryHandle Pin(int elementIndex = 0) {
+      if (elementIndex < 0 || elementIndex > (int)span.size.ToUInt64())
+        throw new global::System.ArgumentOutOfRangeException("elementIndex");
+      return new global::System.Buffers.MemoryHandle((T *)span.data + elementIndex);
+    }
+
+    public override void Unpin() {
+    }
+
+    protected override void Dispose(bool disposing) {
+    }
+  }
+%}
+
+%define CSHARP_ARRAYS_SPAN( CTYPE, CSTYPE )
+
+// input arrays
+
+%typemap(ctype)   (CTYPE *SPAN, size_t LENGTH), (const CTYPE *SPAN, size_t LENGTH) "SWIG_CSharpSpan"
+%typemap(imtype)  (CTYPE *SPAN, size_t LENGTH), (const CTYPE *SPAN, size_t LENGTH) "SWIGSpan"
+%typemap(cstype)  (CTYPE *SPAN, size_t LENGTH) "global::System.Span<CSTYPE>"
+%typemap(cstype)  (const CTYPE *SPAN, size_t LENGTH) "global::System.ReadOnlySpan<CSTYPE>"
+%typemap(csin,
+           pre=       "    unsafe { fixed ( CSTYPE* swig_ptrTo_$csinput = $csinput ) {",
+           terminator="    } }")
+                  (CTYPE *SPAN, size_t LENGTH), (const CTYPE *SPAN, size_t LENGTH)
+                  "new $imclassname.SWIGSpan((global::System.IntPtr)swig_ptrTo_$csinput, $csinput.Length)"
+
+%typemap(in)      (CTYPE *SPAN, size_t LENGTH), (const CTYPE *SPAN, size_t LENGTH)
+%{ $1 = ($1_ltype)$input.data;
+   $2 = ($2_ltype)$input.size; %}
+%typemap(freearg) (CTYPE *SPAN, size_t LENGTH), (const CTYPE *SPAN, size_t LENGTH) ""
+%typemap(argout)  (CTYPE *SPAN, size_t LENGTH), (const CTYPE *SPAN, size_t LENGTH) ""
+
+#ifdef __cplusplus
+
+// returned vectors
+
+%typemap(ctype, out="SWIG_CSharpSpan")
+                  std::vector< CTYPE > &SPAN, const std::vector< CTYPE > &SPAN,
+                  std::vector< CTYPE > &MEMORY, const std::vector< CTYPE > &MEMORY "SWIG_CSharpSpan"
+%typemap(imtype)  std::vector< CTYPE > &SPAN, const std::vector< CTYPE > &SPAN,
+                  std::vector< CTYPE > &MEMORY, const std::vector< CTYPE > &MEMORY "SWIGSpan"
+%typemap(cstype)  std::vector< CTYPE > &SPAN "global::System.Span<CSTYPE>"
+%typemap(cstype)  const std::vector< CTYPE > &SPAN "global::System.ReadOnlySpan<CSTYPE>"
+%typemap(cstype)  std::vector< CTYPE > &MEMORY "global::System.Memory<CSTYPE>"
+%typemap(cstype)  const std::vector< CTYPE > &MEMORY "global::System.ReadOnlyMemory<CSTYPE>"
+
+%typemap(out, null="SWIG_CSharpSpan()")
+                  std::vector< CTYPE > &SPAN, const std::vector< CTYPE > &SPAN,
+                  std::vector< CTYPE > &MEMORY, const std::vector< CTYPE > &MEMORY
+%{ $result.data = $1->empty() ? 0 : (void *)&(*$1)[0];
+   $result.size = $1->size(); %}
+
+%typemap(csout, excode=SWIGEXCODE) std::vector< CTYPE > &SPAN, const std::vector< CTYPE > &SPAN {
+    $imclassname.SWIGSpan ret = $imcall;$excode
+    return ret.ToSpan<CSTYPE>();
+  }
+%typemap(csout, excode=SWIGEXCODE) std::vector< CTYPE > &MEMORY, const std::vector< CTYPE > &MEMORY {
+    $imclassname.SWIGSpan ret = $imcall;$excode
+    return new $imclassname.SWIGMemoryManager<CSTYPE>(this, ret).Memory;
+  }
+
+#endif
+
+%enddef // CSHARP_ARRAYS_SPAN
+
+CSHARP_ARRAYS_SPAN(signed char, sbyte)
+CSHARP_ARRAYS_SPAN(unsigned char, byte)
+CSHARP_ARRAYS_SPAN(short, short)
+CSHARP_ARRAYS_SPAN(unsigned short, ushort)
+CSHARP_ARRAYS_SPAN(int, int)
+CSHARP_ARRAYS_SPAN(unsigned int, uint)
+CSHARP_ARRAYS_SPAN(long long, long)
+CSHARP_ARRAYS_SPAN(unsigned long long, ulong)
+CSHARP_ARRAYS_SPAN(float, float)
+CSHARP_ARRAYS_SPAN(double, double)
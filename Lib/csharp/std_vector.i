@@ -14,6 +14,10 @@
  *   SWIG_STD_VECTOR_ENHANCED(SomeNamespace::Klass)
  *   %template(VectKlass) std::vector<SomeNamespace::Klass>;
  *
+ * When T is a primitive type, CopyTo, ToArray and the constructors copy all the elements in a
+ * single call instead of one call per element. AddArray and SetArray are also available to copy
+ * an array of elements into the vector in a single call.
+ *
  * Warning: heavy macro usage in this file. Use swig -E to get a sane view on the real file contents!
  * ----------------------------------------------------------------------------- */
 
@@ -23,25 +27,9 @@
 %include <std_common.i>
 
 // MACRO for use within the std::vector class body
-%define SWIG_STD_VECTOR_MINIMUM_INTERNAL(CSINTERFACE, CONST_REFERENCE, CTYPE...)
+%define SWIG_STD_VECTOR_COMMON_INTERNAL(CSINTERFACE, CONST_REFERENCE, CTYPE...)
 %typemap(csinterfaces) std::vector< CTYPE > "global::System.IDisposable, global::System.Collections.IEnumerable\n    , global::System.Collections.Generic.CSINTERFACE<$typemap(cstype, CTYPE)>\n";
 %proxycode %{
-  public $csclassname(global::System.Collections.IEnumerable c) : this() {
-    if (c == null)
-      throw new global::System.ArgumentNullException("c");
-    foreach ($typemap(cstype, CTYPE) element in c) {
-      this.Add(element);
-    }
-  }
-
-  public $csclassname(global::System.Collections.Generic.IEnumerable<$typemap(cstype, CTYPE)> c) : this() {
-    if (c == null)
-      throw new global::System.ArgumentNullException("c");
-    foreach ($typemap(cstype, CTYPE) element in c) {
-      this.Add(element);
-    }
-  }
-
   public bool IsFixedSize {
     get {
       return false;
@@ -96,24 +84,6 @@
     CopyTo(0, array, arrayIndex, this.Count);
   }
 
-  public void CopyTo(int index, $typemap(cstype, CTYPE)[] array, int arrayIndex, int count)
-  {
-    if (array == null)
-      throw new global::System.ArgumentNullException("array");
-    if (index < 0)
-      throw new global::System.ArgumentOutOfRangeException("index", "Value is less than zero");
-    if (arrayIndex < 0)
-      throw new global::System.ArgumentOutOfRangeException("arrayIndex", "Value is less than zero");
-    if (count < 0)
-      throw new global::System.ArgumentOutOfRangeException("count", "Value is less than zero");
-    if (array.Rank > 1)
-      throw new global::System.ArgumentException("Multi dimensional array.", "array");
-    if (index+count > this.Count || arrayIndex+count > array.Length)
-      throw new global::System.ArgumentException("Number of elements to copy is too large.");
-    for (int i=0; i<count; i++)
-      array.SetValue(getitemcopy(index+i), arrayIndex+i);
-  }
-
   public $typemap(cstype, CTYPE)[] ToArray() {
     $typemap(cstype, CTYPE)[] array = new $typemap(cstype, CTYPE)[this.Count];
     this.CopyTo(array);
@@ -313,6 +283,151 @@
     }
 %enddef
 
+%define SWIG_STD_VECTOR_MINIMUM_INTERNAL(CSINTERFACE, CONST_REFERENCE, CTYPE...)
+%proxycode %{
+  public $csclassname(global::System.Collections.IEnumerable c) : this() {
+    if (c == null)
+      throw new global::System.ArgumentNullException("c");
+    foreach ($typemap(cstype, CTYPE) element in c) {
+      this.Add(element);
+    }
+  }
+
+  public $csclassname(global::System.Collections.Generic.IEnumerable<$typemap(cstype, CTYPE)> c) : this() {
+    if (c == null)
+      throw new global::System.ArgumentNullException("c");
+    foreach ($typemap(cstype, CTYPE) element in c) {
+      this.Add(element);
+    }
+  }
+
+  public void CopyTo(int index, $typemap(cstype, CTYPE)[] array, int arrayIndex, int count)
+  {
+    if (array == null)
+      throw new global::System.ArgumentNullException("array");
+    if (index < 0)
+      throw new global::System.ArgumentOutOfRangeException("index", "Value is less than zero");
+    if (arrayIndex < 0)
+      throw new global::System.ArgumentOutOfRangeException("arrayIndex", "Value is less than zero");
+    if (count < 0)
+      throw new global::System.ArgumentOutOfRangeException("count", "Value is less than zero");
+    if (array.Rank > 1)
+      throw new global::System.ArgumentException("Multi dimensional array.", "array");
+    if (index+count > this.Count || arrayIndex+count > array.Length)
+      throw new global::System.ArgumentException("Number of elements to copy is too large.");
+    for (int i=0; i<count; i++)
+      array.SetValue(getitemcopy(index+i), arrayIndex+i);
+  }
+%}
+SWIG_STD_VECTOR_COMMON_INTERNAL(CSINTERFACE, %arg(CONST_REFERENCE), %arg(CTYPE))
+%enddef
+
+// Arrays of the primitive types are passed to the bulk copy methods below with the
+// default p/invoke marshaling, which pins rather than copies blittable arrays.
+%define SWIG_STD_VECTOR_ARRAY_TYPEMAPS(CSTYPE, PTYPE...)
+%typemap(ctype)   PTYPE *SWIG_VECTOR_OUTPUT, const PTYPE *SWIG_VECTOR_INPUT "PTYPE *"
+%typemap(cstype)  PTYPE *SWIG_VECTOR_OUTPUT, const PTYPE *SWIG_VECTOR_INPUT "CSTYPE[]"
+%typemap(imtype, inattributes="[global::System.Runtime.InteropServices.Out, global::System.Runtime.InteropServices.MarshalAs(global::System.Runtime.InteropServices.UnmanagedType.LPArray)]") PTYPE *SWIG_VECTOR_OUTPUT "CSTYPE[]"
+%typemap(imtype, inattributes="[global::System.Runtime.InteropServices.In, global::System.Runtime.InteropServices.MarshalAs(global::System.Runtime.InteropServices.UnmanagedType.LPArray)]") const PTYPE *SWIG_VECTOR_INPUT "CSTYPE[]"
+%typemap(csin)    PTYPE *SWIG_VECTOR_OUTPUT, const PTYPE *SWIG_VECTOR_INPUT "$csinput"
+%typemap(in)      PTYPE *SWIG_VECTOR_OUTPUT, const PTYPE *SWIG_VECTOR_INPUT "$1 = $input;"
+%enddef
+
+SWIG_STD_VECTOR_ARRAY_TYPEMAPS(sbyte, signed char)
+SWIG_STD_VECTOR_ARRAY_TYPEMAPS(byte, unsigned char)
+SWIG_STD_VECTOR_ARRAY_TYPEMAPS(short, short)
+SWIG_STD_VECTOR_ARRAY_TYPEMAPS(ushort, unsigned short)
+SWIG_STD_VECTOR_ARRAY_TYPEMAPS(int, int)
+SWIG_STD_VECTOR_ARRAY_TYPEMAPS(uint, unsigned int)
+SWIG_STD_VECTOR_ARRAY_TYPEMAPS(long, long long)
+SWIG_STD_VECTOR_ARRAY_TYPEMAPS(ulong, unsigned long long)
+SWIG_STD_VECTOR_ARRAY_TYPEMAPS(float, float)
+SWIG_STD_VECTOR_ARRAY_TYPEMAPS(double, double)
+
+// MACRO for use within the std::vector class body for the primitive types, the elements
+// are copied to and from C# arrays of CSTYPE in a single call rather than one call per element.
+// PTYPE is the C type marshaled as CSTYPE, it differs from CTYPE when C# has no type of the same size.
+%define SWIG_STD_VECTOR_PRIMITIVE_INTERNAL(CSTYPE, PTYPE, CTYPE...)
+%proxycode %{
+  public $csclassname(global::System.Collections.IEnumerable c) : this() {
+    if (c == null)
+      throw new global::System.ArgumentNullException("c");
+    global::System.Collections.Generic.ICollection<CSTYPE> collection = c as global::System.Collections.Generic.ICollection<CSTYPE>;
+    if (collection != null) {
+      CSTYPE[] array = new CSTYPE[collection.Count];
+      collection.CopyTo(array, 0);
+      this.AddArray(array);
+    } else {
+      foreach (CSTYPE element in c) {
+        this.Add(element);
+      }
+    }
+  }
+
+  public $csclassname(global::System.Collections.Generic.IEnumerable<CSTYPE> c) : this() {
+    if (c == null)
+      throw new global::System.ArgumentNullException("c");
+    CSTYPE[] array = c as CSTYPE[];
+    if (array == null) {
+      global::System.Collections.Generic.ICollection<CSTYPE> collection = c as global::System.Collections.Generic.ICollection<CSTYPE>;
+      if (collection == null) {
+        foreach (CSTYPE element in c) {
+          this.Add(element);
+        }
+        return;
+      }
+      array = new CSTYPE[collection.Count];
+      collection.CopyTo(array, 0);
+    }
+    this.AddArray(array);
+  }
+
+  public void CopyTo(int index, CSTYPE[] array, int arrayIndex, int count)
+  {
+    if (array == null)
+      throw new global::System.ArgumentNullException("array");
+    if (index < 0)
+      throw new global::System.ArgumentOutOfRangeException("index", "Value is less than zero");
+    if (arrayIndex < 0)
+      throw new global::System.ArgumentOutOfRangeException("arrayIndex", "Value is less than zero");
+    if (count < 0)
+      throw new global::System.ArgumentOutOfRangeException("count", "Value is less than zero");
+    if (index+count > this.Count || arrayIndex+count > array.Length)
+      throw new global::System.ArgumentException("Number of elements to copy is too large.");
+    if (count > 0)
+      getitems(index, array, arrayIndex, count);
+  }
+
+  public void AddArray(CSTYPE[] values) {
+    if (values == null)
+      throw new global::System.ArgumentNullException("values");
+    if (values.Length > 0)
+      additems(values, values.Length);
+  }
+
+  public void SetArray(int index, CSTYPE[] values) {
+    if (values == null)
+      throw new global::System.ArgumentNullException("values");
+    if (index < 0 || index+values.Length > this.Count)
+      throw new global::System.ArgumentOutOfRangeException("index");
+    if (values.Length > 0)
+      setitems(index, values, values.Length);
+  }
+%}
+SWIG_STD_VECTOR_COMMON_INTERNAL(IList, CTYPE const&, CTYPE)
+    %extend {
+      void getitems(int index, PTYPE *SWIG_VECTOR_OUTPUT, int arrayIndex, int count) {
+        std::copy($self->begin()+index, $self->begin()+index+count, SWIG_VECTOR_OUTPUT+arrayIndex);
+      }
+      void additems(const PTYPE *SWIG_VECTOR_INPUT, int count) {
+        $self->insert($self->end(), SWIG_VECTOR_INPUT, SWIG_VECTOR_INPUT+count);
+      }
+      void setitems(int index, const PTYPE *SWIG_VECTOR_INPUT, int count) {
+        std::copy(SWIG_VECTOR_INPUT, SWIG_VECTOR_INPUT+count, $self->begin()+index);
+      }
+    }
+%enddef
+
 // Extra methods added to the collection class if operator== is defined for the class being wrapped
 // The class will then implement IList<>, which adds extra functionality
 %define SWIG_STD_VECTOR_EXTRA_OP_EQUALS_EQUALS(CTYPE...)
@@ -355,6 +470,15 @@ namespace std {
 }
 %enddef
 
+%define SWIG_STD_VECTOR_PRIMITIVE(CSTYPE, PTYPE, CTYPE...)
+namespace std {
+  template<> class vector< CTYPE > {
+    SWIG_STD_VECTOR_PRIMITIVE_INTERNAL(CSTYPE, PTYPE, CTYPE)
+    SWIG_STD_VECTOR_EXTRA_OP_EQUALS_EQUALS(CTYPE)
+  };
+}
+%enddef
+
 // Legacy macros
 %define SWIG_STD_VECTOR_SPECIALIZE(CSTYPE, CTYPE...)
 #warning SWIG_STD_VECTOR_SPECIALIZE macro deprecated, please see csharp/std_vector.i and switch to SWIG_STD_VECTOR_ENHANCED
@@ -377,6 +501,9 @@ SWIG_STD_VECTOR_ENHANCED(CTYPE)
 %csmethodmodifiers std::vector::size "private"
 %csmethodmodifiers std::vector::capacity "private"
 %csmethodmodifiers std::vector::reserve "private"
+%csmethodmodifiers std::vector::getitems "private"
+%csmethodmodifiers std::vector::additems "private"
+%csmethodmodifiers std::vector::setitems "private"
 
 namespace std {
   // primary (unspecialized) class template for std::vector
@@ -398,19 +525,20 @@ namespace std {
 
 // template specializations for std::vector
 // these provide extra collections methods as operator== is defined
-SWIG_STD_VECTOR_ENHANCED(char)
-SWIG_STD_VECTOR_ENHANCED(signed char)
-SWIG_STD_VECTOR_ENHANCED(unsigned char)
-SWIG_STD_VECTOR_ENHANCED(short)
-SWIG_STD_VECTOR_ENHANCED(unsigned short)
-SWIG_STD_VECTOR_ENHANCED(int)
-SWIG_STD_VECTOR_ENHANCED(unsigned int)
-SWIG_STD_VECTOR_ENHANCED(long)
-SWIG_STD_VECTOR_ENHANCED(unsigned long)
-SWIG_STD_VECTOR_ENHANCED(long long)
-SWIG_STD_VECTOR_ENHANCED(unsigned long long)
-SWIG_STD_VECTOR_ENHANCED(float)
-SWIG_STD_VECTOR_ENHANCED(double)
+// and bulk copies to and from arrays for the primitive types
+SWIG_STD_VECTOR_ENHANCED(char) // C# char is not blittable so cannot use the bulk copies
+SWIG_STD_VECTOR_PRIMITIVE(sbyte, signed char, signed char)
+SWIG_STD_VECTOR_PRIMITIVE(byte, unsigned char, unsigned char)
+SWIG_STD_VECTOR_PRIMITIVE(short, short, short)
+SWIG_STD_VECTOR_PRIMITIVE(ushort, unsigned short, unsigned short)
+SWIG_STD_VECTOR_PRIMITIVE(int, int, int)
+SWIG_STD_VECTOR_PRIMITIVE(uint, unsigned int, unsigned int)
+SWIG_STD_VECTOR_PRIMITIVE(int, int, long)
+SWIG_STD_VECTOR_PRIMITIVE(uint, unsigned int, unsigned long)
+SWIG_STD_VECTOR_PRIMITIVE(long, long long, long long)
+SWIG_STD_VECTOR_PRIMITIVE(ulong, unsigned long long, unsigned long long)
+SWIG_STD_VECTOR_PRIMITIVE(float, float, float)
+SWIG_STD_VECTOR_PRIMITIVE(double, double, double)
 SWIG_STD_VECTOR_ENHANCED(std::string) // also requires a %include <std_string.i>
 SWIG_STD_VECTOR_ENHANCED(std::wstring) // also requires a %include <std_wstring.i>
 
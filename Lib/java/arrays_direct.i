@@ -0,0 +1,140 @@
+/* -----------------------------------------------------------------------------
+ * arrays_direct.i
+ *
+ * Typemaps giving C/C++ direct access to the memory of Java primitive arrays and
+ * java.nio direct buffers, so that numeric data is not copied in and out on each
+ * call as it is with the arrays_java.i typemaps.  The typemaps are not used by
+ * default, they are applied to the parameters that need them.
+ *
+ * CRITICAL typemaps map a C array to a Java primitive array of the same element
+ * size, pinned with GetPrimitiveArrayCritical for the duration of the call.  The
+ * JVM may suspend garbage collection until the array is released, so they are only
+ * suitable for short calls that do not block or call back into Java.  No other JNI
+ * call may be made while the array is pinned, so a wrapped function can only have
+ * one CRITICAL parameter and its other parameters and return type must be
+ * primitive types.  For the same reason the wrapped function must not throw a C++
+ * exception that is converted into a Java exception by a throws typemap or an
+ * %exception handler, as the array is still pinned when the exception is thrown:
+ *
+ *   %apply double *CRITICAL { double *data };
+ *   %apply (double *CRITICAL, size_t LENGTH) { (double *data, size_t n) };
+ *   void scale(double *data, size_t n, double factor);
+ *
+ *   double[] values = new double[] {1.0, 2.0, 3.0};
+ *   example.scale(values, 2.0);
+ *
+ * DIRECTBUFFER typemaps map a C array to a java.nio buffer allocated with
+ * allocateDirect, the C code then uses the buffer memory itself.  Buffers of
+ * types other than ByteBuffer are views of a direct ByteBuffer and must use the
+ * native byte order:
+ *
+ *   %apply (double *DIRECTBUFFER, size_t LENGTH) { (double *data, size_t n) };
+ *   void scale(double *data, size_t n, double factor);
+ *
+ *   java.nio.DoubleBuffer buffer = java.nio.ByteBuffer.allocateDirect(3*8)
+ *       .order(java.nio.ByteOrder.nativeOrder()).asDoubleBuffer();
+ *   example.scale(buffer, 2.0);
+ *
+ * The LENGTH parameter receives the length of the Java array or the capacity of
+ * the buffer, in elements.  The unsigned C types use the signed Java type of the
+ * same size, so their values are reinterpreted rather than widened.
+ * ----------------------------------------------------------------------------- */
+
+%define JAVA_ARRAYS_DIRECT_TYPEMAPS(CTYPE, JTYPE, JNITYPE, JBUFFER)
+
+/* CTYPE *CRITICAL, CTYPE CRITICAL[] */
+%typemap(jni) CTYPE *CRITICAL, CTYPE CRITICAL[], (CTYPE *CRITICAL, size_t LENGTH) %{JNITYPE##Array%}
+%typemap(jtype) CTYPE *CRITICAL, CTYPE CRITICAL[], (CTYPE *CRITICAL, size_t LENGTH) %{JTYPE[]%}
+%typemap(jstype) CTYPE *CRITICAL, CTYPE CRITICAL[], (CTYPE *CRITICAL, size_t LENGTH) %{JTYPE[]%}
+%typemap(javain) CTYPE *CRITICAL, CTYPE CRITICAL[], (CTYPE *CRITICAL, size_t LENGTH) "$javainput"
+
+%typemap(in) CTYPE *CRITICAL, CTYPE CRITICAL[]
+%{  if (!$input) {
+    SWIG_JavaThrowException(jenv, SWIG_JavaNullPointerException, "null array");
+    return $null;
+  }
+  $1 = ($1_ltype)JCALL2(GetPrimitiveArrayCritical, jenv, $input, 0);
+  if (!$1) return $null; %}
+%typemap(in) (CTYPE *CRITICAL, size_t LENGTH)
+%{  if (!$input) {
+    SWIG_JavaThrowException(jenv, SWIG_JavaNullPointerException, "null array");
+    return $null;
+  }
+  $2 = ($2_ltype)JCALL1(GetArrayLength, jenv, $input);
+  $1 = ($1_ltype)JCALL2(GetPrimitiveArrayCritical, jenv, $input, 0);
+  if (!$1) return $null; %}
+%typemap(argout) CTYPE *CRITICAL, CTYPE CRITICAL[], (CTYPE *CRITICAL, size_t LENGTH) ""
+%typemap(freearg) CTYPE *CRITICAL, CTYPE CRITICAL[], (CTYPE *CRITICAL, size_t LENGTH)
+%{ JCALL3(ReleasePrimitiveArrayCritical, jenv, $input, (void *)$1, 0); %}
+
+/* CTYPE *DIRECTBUFFER */
+%typemap(jni) CTYPE *DIRECTBUFFER, (CTYPE *DIRECTBUFFER, size_t LENGTH) "jobject"
+%typemap(jtype) CTYPE *DIRECTBUFFER, (CTYPE *DIRECTBUFFER, size_t LENGTH) "java.nio.JBUFFER"
+%typemap(jstype) CTYPE *DIRECTBUFFER, (CTYPE *DIRECTBUFFER, size_t LENGTH) "java.nio.JBUFFER"
+%typemap(javain,
+  pre="    assert $javainput.isDirect() : \"Buffer must be allocated direct.\";") CTYPE *DIRECTBUFFER, (CTYPE *DIRECTBUFFER, size_t LENGTH) "$javainput"
+
+%typemap(in) CTYPE *DIRECTBUFFER
+%{  if (!$input) {
+    SWIG_JavaThrowException(jenv, SWIG_JavaNullPointerException, "null buffer");
+    return $null;
+  }
+  $1 = ($1_ltype)JCALL1(GetDirectBufferAddress, jenv, $input);
+  if (!$1) {
+    SWIG_JavaThrowException(jenv, SWIG_JavaRuntimeException, "Unable to get address of a java.nio.JBUFFER, it must be a direct buffer.");
+    return $null;
+  } %}
+%typemap(in) (CTYPE *DIRECTBUFFER, size_t LENGTH)
+%{  if (!$input) {
+    SWIG_JavaThrowException(jenv, SWIG_JavaNullPointerException, "null buffer");
+    return $null;
+  }
+  $1 = ($1_ltype)JCALL1(GetDirectBufferAddress, jenv, $input);
+  if (!$1) {
+    SWIG_JavaThrowException(jenv, SWIG_JavaRuntimeException, "Unable to get address of a java.nio.JBUFFER, it must be a direct buffer.");
+    return $null;
+  }
+  $2 = ($2_ltype)JCALL1(GetDirectBufferCapacity, jenv, $input); %}
+%typemap(freearg) CTYPE *DIRECTBUFFER, (CTYPE *DIRECTBUFFER, size_t LENGTH) ""
+
+%enddef
+
+JAVA_ARRAYS_DIRECT_TYPEMAPS(signed char, byte, jbyte, ByteBuffer)
+JAVA_ARRAYS_DIRECT_TYPEMAPS(unsigned char, byte, jbyte, ByteBuffer)
+JAVA_ARRAYS_DIRECT_TYPEMAPS(short, short, jshort, ShortBuffer)
+JAVA_ARRAYS_DIRECT_TYPEMAPS(unsigned short, short, jshort, ShortBuffer)
+JAVA_ARRAYS_DIRECT_TYPEMAPS(int, int, jint, IntBuffer)
+JAVA_ARRAYS_DIRECT_TYPEMAPS(unsigned int, int, jint, IntBuffer)
+JAVA_ARRAYS_DIRECT_TYPEMAPS(long long, long, jlong, LongBuffer)
+JAVA_ARRAYS_DIRECT_TYPEMAPS(unsigned long long, long, jlong, LongBuffer)
+JAVA_ARRAYS_DIRECT_TYPEMAPS(float, float, jfloat, FloatBuffer)
+JAVA_ARRAYS_DIRECT_TYPEMAPS(double, double, jdouble, DoubleBuffer)
+
+
+%typecheck(SWIG_TYPECHECK_INT8_ARRAY) /* Java byte[] */
+    signed char *CRITICAL, signed char CRITICAL[],
+    unsigned char *CRITICAL, unsigned char CRITICAL[]
+    ""
+
+%typecheck(SWIG_TYPECHECK_INT16_ARRAY) /* Java short[] */
+    short *CRITICAL, short CRITICAL[],
+    unsigned short *CRITICAL, unsigned short CRITICAL[]
+    ""
+
+%typecheck(SWIG_TYPECHECK_INT32_ARRAY) /* Java int[] */
+    int *CRITICAL, int CRITICAL[],
+    unsigned int *CRITICAL, unsigned int CRITICAL[]
+    ""
+
+%typecheck(SWIG_TYPECHECK_INT64_ARRAY) /* Java long[] */
+    long long *CRITICAL, long long CRITICAL[],
+    unsigned long long *CRITICAL, unsigned long long CRITICAL[]
+    ""
+
+%typecheck(SWIG_TYPECHECK_FLOAT_ARRAY) /* Java float[] */
+    float *CRITICAL, float CRITICAL[]
+    ""
+
+%typecheck(SWIG_TYPECHECK_DOUBLE_ARRAY) /* Java double[] */
+    double *CRITICAL, double CRITICAL[]
+    ""
@@ -5,12 +5,25 @@
  * The Java proxy class extends java.util.AbstractList and implements
  * java.util.RandomAccess. The std::vector container looks and feels much like a
  * java.util.ArrayList from Java.
+ *
+ * Vectors of the primitive types have extra methods that copy many elements in a
+ * single JNI call rather than one call per element:
+ *
+ *   double[] toPrimitiveArray()
+ *   double[] getRange(int fromIndex, int toIndex)
+ *   void copyTo(double[] dst, int offset)
+ *   void copyTo(int fromIndex, int toIndex, double[] dst, int offset)
+ *   boolean addAllArray(double[] elements)
+ *   void setRange(int index, double[] elements)
+ *
+ * The constructors taking an array or an Iterable also use these bulk copies.
  * ----------------------------------------------------------------------------- */
 
 %include <std_common.i>
 
 %{
 #include <vector>
+#include <algorithm>
 #include <stdexcept>
 %}
 
@@ -23,24 +36,10 @@ SWIGINTERN jint SWIG_VectorSize(size_t size) {
 }
 }
 
-%define SWIG_STD_VECTOR_MINIMUM_INTERNAL(CTYPE, CREF_TYPE)
+%define SWIG_STD_VECTOR_COMMON_INTERNAL(CTYPE, CREF_TYPE)
 %typemap(javabase) std::vector< CTYPE > "java.util.AbstractList<$typemap(jboxtype, CTYPE)>"
 %typemap(javainterfaces) std::vector< CTYPE > "java.util.RandomAccess"
 %proxycode %{
-  public $javaclassname($typemap(jstype, CTYPE)[] initialElements) {
-    this();
-    for ($typemap(jstype, CTYPE) element : initialElements) {
-      add(element);
-    }
-  }
-
-  public $javaclassname(Iterable<$typemap(jboxtype, CTYPE)> initialElements) {
-    this();
-    for ($typemap(jstype, CTYPE) element : initialElements) {
-      add(element);
-    }
-  }
-
   public $typemap(jboxtype, CTYPE) get(int index) {
     return doGet(index);
   }
@@ -163,12 +162,140 @@ SWIGINTERN jint SWIG_VectorSize(size_t size) {
     }
 %enddef
 
+%define SWIG_STD_VECTOR_MINIMUM_INTERNAL(CTYPE, CREF_TYPE)
+%proxycode %{
+  public $javaclassname($typemap(jstype, CTYPE)[] initialElements) {
+    this();
+    for ($typemap(jstype, CTYPE) element : initialElements) {
+      add(element);
+    }
+  }
+
+  public $javaclassname(Iterable<$typemap(jboxtype, CTYPE)> initialElements) {
+    this();
+    for ($typemap(jstype, CTYPE) element : initialElements) {
+      add(element);
+    }
+  }
+%}
+SWIG_STD_VECTOR_COMMON_INTERNAL(CTYPE, CREF_TYPE)
+%enddef
+
+// Bulk copies between a vector of a primitive type and a Java array of the
+// corresponding Java type. The array is pinned for the duration of the copy so
+// the native methods must not make any other JNI calls, the range checks are all
+// done in Java before the native method is called.
+%define SWIG_STD_VECTOR_ARRAY_TYPEMAPS(JNITYPE, JTYPE)
+%typemap(jni) JNITYPE *SWIG_VECTOR_ARRAY, const JNITYPE *SWIG_VECTOR_ARRAY %{JNITYPE##Array%}
+%typemap(jtype) JNITYPE *SWIG_VECTOR_ARRAY, const JNITYPE *SWIG_VECTOR_ARRAY "JTYPE[]"
+%typemap(jstype) JNITYPE *SWIG_VECTOR_ARRAY, const JNITYPE *SWIG_VECTOR_ARRAY "JTYPE[]"
+%typemap(javain) JNITYPE *SWIG_VECTOR_ARRAY, const JNITYPE *SWIG_VECTOR_ARRAY "$javainput"
+%typemap(in) JNITYPE *SWIG_VECTOR_ARRAY, const JNITYPE *SWIG_VECTOR_ARRAY
+%{ $1 = ($1_ltype)JCALL2(GetPrimitiveArrayCritical, jenv, $input, 0);
+  if (!$1) return $null; %}
+%typemap(argout) JNITYPE *SWIG_VECTOR_ARRAY
+%{ JCALL3(ReleasePrimitiveArrayCritical, jenv, $input, (void *)$1, 0); %}
+%typemap(argout) const JNITYPE *SWIG_VECTOR_ARRAY
+%{ JCALL3(ReleasePrimitiveArrayCritical, jenv, $input, (void *)$1, JNI_ABORT); %}
+%typemap(freearg) JNITYPE *SWIG_VECTOR_ARRAY, const JNITYPE *SWIG_VECTOR_ARRAY ""
+%enddef
+
+SWIG_STD_VECTOR_ARRAY_TYPEMAPS(jbyte, byte)
+SWIG_STD_VECTOR_ARRAY_TYPEMAPS(jchar, char)
+SWIG_STD_VECTOR_ARRAY_TYPEMAPS(jshort, short)
+SWIG_STD_VECTOR_ARRAY_TYPEMAPS(jint, int)
+SWIG_STD_VECTOR_ARRAY_TYPEMAPS(jlong, long)
+SWIG_STD_VECTOR_ARRAY_TYPEMAPS(jfloat, float)
+SWIG_STD_VECTOR_ARRAY_TYPEMAPS(jdouble, double)
+
+%define SWIG_STD_VECTOR_PRIMITIVE_INTERNAL(CTYPE, JTYPE, JNITYPE)
+%proxycode %{
+  public $javaclassname(JTYPE[] initialElements) {
+    this();
+    addAllArray(initialElements);
+  }
+
+  public $javaclassname(Iterable<$typemap(jboxtype, CTYPE)> initialElements) {
+    this();
+    if (initialElements instanceof $javaclassname) {
+      addAllArray((($javaclassname)initialElements).toPrimitiveArray());
+    } else if (initialElements instanceof java.util.Collection) {
+      java.util.Collection<$typemap(jboxtype, CTYPE)> collection = (java.util.Collection<$typemap(jboxtype, CTYPE)>)initialElements;
+      JTYPE[] elements = new JTYPE[collection.size()];
+      int i = 0;
+      for (JTYPE element : collection) {
+        elements[i++] = element;
+      }
+      addAllArray(elements);
+    } else {
+      for (JTYPE element : initialElements) {
+        add(element);
+      }
+    }
+  }
+
+  public JTYPE[] toPrimitiveArray() {
+    return getRange(0, size());
+  }
+
+  public JTYPE[] getRange(int fromIndex, int toIndex) {
+    if (fromIndex < 0 || fromIndex > toIndex || toIndex > size())
+      throw new IndexOutOfBoundsException("vector range [" + fromIndex + ", " + toIndex + ") out of range");
+    JTYPE[] array = new JTYPE[toIndex - fromIndex];
+    doCopyTo(fromIndex, array, 0, array.length);
+    return array;
+  }
+
+  public void copyTo(JTYPE[] dst, int offset) {
+    copyTo(0, size(), dst, offset);
+  }
+
+  public void copyTo(int fromIndex, int toIndex, JTYPE[] dst, int offset) {
+    if (fromIndex < 0 || fromIndex > toIndex || toIndex > size())
+      throw new IndexOutOfBoundsException("vector range [" + fromIndex + ", " + toIndex + ") out of range");
+    if (offset < 0 || offset > dst.length - (toIndex - fromIndex))
+      throw new IndexOutOfBoundsException("array offset out of range");
+    doCopyTo(fromIndex, dst, offset, toIndex - fromIndex);
+  }
+
+  // Not an addAll overload as addAll(null) would then be ambiguous
+  public boolean addAllArray(JTYPE[] elements) {
+    modCount++;
+    doAddAll(elements, 0, elements.length);
+    return elements.length != 0;
+  }
+
+  public void setRange(int index, JTYPE[] elements) {
+    if (index < 0 || index > size() - elements.length)
+      throw new IndexOutOfBoundsException("vector index out of range");
+    doSetRange(index, elements, 0, elements.length);
+  }
+%}
+SWIG_STD_VECTOR_COMMON_INTERNAL(CTYPE, const CTYPE&)
+    %extend {
+      void doCopyTo(jint index, JNITYPE *SWIG_VECTOR_ARRAY, jint offset, jint count) {
+        std::copy(self->begin() + index, self->begin() + index + count, SWIG_VECTOR_ARRAY + offset);
+      }
+
+      void doAddAll(const JNITYPE *SWIG_VECTOR_ARRAY, jint offset, jint count) {
+        self->insert(self->end(), SWIG_VECTOR_ARRAY + offset, SWIG_VECTOR_ARRAY + offset + count);
+      }
+
+      void doSetRange(jint index, const JNITYPE *SWIG_VECTOR_ARRAY, jint offset, jint count) {
+        std::copy(SWIG_VECTOR_ARRAY + offset, SWIG_VECTOR_ARRAY + offset + count, self->begin() + index);
+      }
+    }
+%enddef
+
 %javamethodmodifiers std::vector::doSize        "private";
 %javamethodmodifiers std::vector::doAdd         "private";
 %javamethodmodifiers std::vector::doGet         "private";
 %javamethodmodifiers std::vector::doSet         "private";
 %javamethodmodifiers std::vector::doRemove      "private";
 %javamethodmodifiers std::vector::doRemoveRange "private";
+%javamethodmodifiers std::vector::doCopyTo      "private";
+%javamethodmodifiers std::vector::doAddAll      "private";
+%javamethodmodifiers std::vector::doSetRange    "private";
 
 namespace std {
 
@@ -182,6 +309,29 @@ namespace std {
     };
 }
 
+%define SWIG_STD_VECTOR_PRIMITIVE(CTYPE, JTYPE, JNITYPE)
+namespace std {
+    template<> class vector< CTYPE > {
+        SWIG_STD_VECTOR_PRIMITIVE_INTERNAL(CTYPE, JTYPE, JNITYPE)
+    };
+}
+%enddef
+
+// primitive specializations with bulk copies, unsigned long long is not included
+// as it maps to java.math.BigInteger
+SWIG_STD_VECTOR_PRIMITIVE(char, char, jchar)
+SWIG_STD_VECTOR_PRIMITIVE(signed char, byte, jbyte)
+SWIG_STD_VECTOR_PRIMITIVE(unsigned char, short, jshort)
+SWIG_STD_VECTOR_PRIMITIVE(short, short, jshort)
+SWIG_STD_VECTOR_PRIMITIVE(unsigned short, int, jint)
+SWIG_STD_VECTOR_PRIMITIVE(int, int, jint)
+SWIG_STD_VECTOR_PRIMITIVE(unsigned int, long, jlong)
+SWIG_STD_VECTOR_PRIMITIVE(long, int, jint)
+SWIG_STD_VECTOR_PRIMITIVE(unsigned long, long, jlong)
+SWIG_STD_VECTOR_PRIMITIVE(long long, long, jlong)
+SWIG_STD_VECTOR_PRIMITIVE(float, float, jfloat)
+SWIG_STD_VECTOR_PRIMITIVE(double, double, jdouble)
+
 %define specialize_std_vector(T)
 #warning "specialize_std_vector - specialization for type T no longer needed"
 %enddef
@@ -2,7 +2,7 @@
   Vectors
 */
 
-%fragment("StdVectorTraits","header",fragment="StdSequenceTraits")
+%fragment("StdVectorTraits","header",fragment="StdSequenceTraits",fragment="SwigPyBuffer_Cont")
 %{
   namespace swig {
     template <class T>
@@ -15,13 +15,36 @@
     template <class T>
     struct traits_asptr<std::vector<T> >  {
       static int asptr(PyObject *obj, std::vector<T> **vec) {
+#if PY_VERSION_HEX >= 0x02060000
+	SwigPyBuffer_Cont<T> buffer(obj);
+	if (buffer.valid()) {
+	  if (vec)
+	    *vec = new std::vector<T>(buffer.begin(), buffer.end());
+	  return vec ? SWIG_NEWOBJ : SWIG_OK;
+	}
+#endif
 	return traits_asptr_stdseq<std::vector<T> >::asptr(obj, vec);
       }
     };
     
+#if defined(SWIG_PYTHON_VECTOR_BUFFER) && PY_VERSION_HEX >= 0x03030000
+    template <class T>
+    inline PyObject *from_vector_buffer(const std::vector<T>& vec) {
+      return buffer_from(vec.empty() ? 0 : &vec[0], vec.size());
+    }
+
+    inline PyObject *from_vector_buffer(const std::vector<bool>&) {
+      return 0;
+    }
+#endif
+
     template <class T>
     struct traits_from<std::vector<T> > {
       static PyObject *from(const std::vector<T>& vec) {
+#if defined(SWIG_PYTHON_VECTOR_BUFFER) && PY_VERSION_HEX >= 0x03030000
+	if (traits_buffer<T>::format())
+	  return from_vector_buffer(vec);
+#endif
 	return traits_from_stdseq<std::vector<T> >::from(vec);
       }
     };
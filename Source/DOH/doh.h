@@ -102,6 +102,7 @@
 #define DohNewFile         DOH_NAMESPACE(NewFile)
 #define DohNewFileFromFile DOH_NAMESPACE(NewFileFromFile)
 #define DohNewFileFromFd   DOH_NAMESPACE(NewFileFromFd)
+#define DohNewTempFile     DOH_NAMESPACE(NewTempFile)
 #define DohFileErrorDisplay   DOH_NAMESPACE(FileErrorDisplay)
 #define DohClose           DOH_NAMESPACE(Close)
 #define DohCopyto          DOH_NAMESPACE(Copyto)
@@ -114,6 +115,10 @@
 #define DohCall            DOH_NAMESPACE(Call)
 #define DohObjMalloc       DOH_NAMESPACE(ObjMalloc)
 #define DohObjFree         DOH_NAMESPACE(ObjFree)
+#define DohMemMalloc       DOH_NAMESPACE(MemMalloc)
+#define DohMemRealloc      DOH_NAMESPACE(MemRealloc)
+#define DohMemFree         DOH_NAMESPACE(MemFree)
+#define DohSetMemoryArena  DOH_NAMESPACE(SetMemoryArena)
 #define DohMemoryDebug     DOH_NAMESPACE(MemoryDebug)
 #define DohStringType      DOH_NAMESPACE(StringType)
 #define DohListType        DOH_NAMESPACE(ListType)
@@ -165,15 +170,20 @@ typedef struct {
 /* Memory management */
 
 #ifndef DohMalloc
-#define DohMalloc malloc
+#define DohMalloc DohMemMalloc
 #endif
 #ifndef DohRealloc
-#define DohRealloc realloc
+#define DohRealloc DohMemRealloc
 #endif
 #ifndef DohFree
-#define DohFree free
+#define DohFree DohMemFree
 #endif
 
+extern void *DohMemMalloc(size_t size);
+extern void *DohMemRealloc(void *ptr, size_t size);
+extern void DohMemFree(void *ptr);
+extern void DohSetMemoryArena(int enable);
+
 extern int DohCheck(const DOH *ptr);	/* Check if a DOH object */
 extern void DohIntern(DOH *);	/* Intern an object      */
 
@@ -306,6 +316,7 @@ extern char *DohStrchr(const DOHString_or_char *s1, int ch);
 extern DOHFile *DohNewFile(DOH *filename, const char *mode, DOHList *outfiles);
 extern DOHFile *DohNewFileFromFile(FILE *f);
 extern DOHFile *DohNewFileFromFd(int fd);
+extern DOHFile *DohNewTempFile(void);
 extern void DohFileErrorDisplay(DOHString * filename);
 /*
  Deprecated, just use DohDelete
@@ -423,6 +434,7 @@ extern void DohMemoryDebug(void);
 #define NewFile            DohNewFile
 #define NewFileFromFile    DohNewFileFromFile
 #define NewFileFromFd      DohNewFileFromFd
+#define NewTempFile        DohNewTempFile
 #define FileErrorDisplay   DohFileErrorDisplay
 #define Close              DohClose
 #define NewVoid            DohNewVoid
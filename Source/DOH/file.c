@@ -44,6 +44,37 @@ static void DelFile(DOH *fo) {
   DohFree(f);
 }
 
+/* -----------------------------------------------------------------------------
+ * File_dump()
+ *
+ * Copies the whole file to out, for files opened for reading and writing such as
+ * those from NewTempFile().  The file position is left unchanged so that writes
+ * can carry on where they left off.
+ * ----------------------------------------------------------------------------- */
+
+static int File_dump(DOH *fo, DOH *out) {
+  char buffer[16384];
+  int nsent = 0;
+  long pos;
+  size_t nread;
+  DohFile *f = (DohFile *) ObjData(fo);
+  if (!f->filep)
+    return 0;
+  pos = ftell(f->filep);
+  if (pos < 0 || fseek(f->filep, 0, SEEK_SET) != 0)
+    return -1;
+  while ((nread = fread(buffer, 1, sizeof(buffer), f->filep)) > 0) {
+    int ret = Write(out, buffer, (int) nread);
+    if (ret < 0) {
+      nsent = ret;
+      break;
+    }
+    nsent += ret;
+  }
+  fseek(f->filep, pos, SEEK_SET);
+  return nsent;
+}
+
 /* -----------------------------------------------------------------------------
  * File_read()
  * ----------------------------------------------------------------------------- */
@@ -205,7 +236,7 @@ static DohObjInfo DohFileType = {
   0,				/* doh_clear    */
   0,				/* doh_str      */
   0,				/* doh_data     */
-  0,				/* doh_dump     */
+  File_dump,			/* doh_dump     */
   0,				/* doh_len      */
   0,				/* doh_hash     */
   0,				/* doh_cmp      */
@@ -288,6 +319,29 @@ DOH *DohNewFileFromFd(int fd) {
   return DohObjMalloc(&DohFileType, f);
 }
 
+/* -----------------------------------------------------------------------------
+ * NewTempFile()
+ *
+ * Create a file object for an anonymous temporary file, open for reading and
+ * writing and removed once closed.  Returns 0 if the file cannot be created.
+ * ----------------------------------------------------------------------------- */
+
+DOH *DohNewTempFile(void) {
+  DohFile *f;
+  FILE *file = tmpfile();
+  if (!file)
+    return 0;
+  f = (DohFile *) DohMalloc(sizeof(DohFile));
+  if (!f) {
+    fclose(file);
+    return 0;
+  }
+  f->filep = file;
+  f->fd = 0;
+  f->closeondel = 1;
+  return DohObjMalloc(&DohFileType, f);
+}
+
 /* -----------------------------------------------------------------------------
  * FileErrorDisplay()
  *
@@ -19,86 +19,188 @@ extern DohObjInfo DohHashType;
 typedef struct HashNode {
   DOH *key;
   DOH *object;
-  struct HashNode *next;
+  int hashval;			/* Cached Hashval(key) */
 } HashNode;
 
 /* Hash object */
 typedef struct Hash {
   DOH *file;
   int line;
-  HashNode **hashtable;
+  HashNode *hashtable;
   int hashsize;
-  int nitems;
+  int nitems;			/* Number of live entries */
+  int nslots;			/* Number of slots that are not empty (live or deleted) */
 } Hash;
 
 /* Key interning structure */
 typedef struct KeyValue {
   char *cstr;
+  unsigned int hashval;
   DOH *sstr;
-  struct KeyValue *left;
-  struct KeyValue *right;
 } KeyValue;
 
-static KeyValue *root = 0;
+static KeyValue *keytable = 0;
+static unsigned int keytable_size = 0;
+static unsigned int keytable_nitems = 0;
 static int max_expand = 1;
 
+#define KEYTABLE_INIT_SIZE 1024
+
+/* Hash function for C string keys, the table size is always a power of 2 */
+static unsigned int key_hash(const char *c) {
+  unsigned int h = 2166136261U;
+  while (*c) {
+    h ^= (unsigned char) *(c++);
+    h *= 16777619U;
+  }
+  return h;
+}
+
+/* Double the size of the interned key table */
+static void keytable_resize(void) {
+  KeyValue *old = keytable;
+  unsigned int oldsize = keytable_size;
+  unsigned int mask, i;
+
+  keytable_size = oldsize ? oldsize * 2 : KEYTABLE_INIT_SIZE;
+  keytable = (KeyValue *) DohMalloc(keytable_size * sizeof(KeyValue));
+  memset(keytable, 0, keytable_size * sizeof(KeyValue));
+  mask = keytable_size - 1;
+  for (i = 0; i < oldsize; i++) {
+    if (old[i].cstr) {
+      unsigned int j = old[i].hashval & mask;
+      while (keytable[j].cstr)
+	j = (j + 1) & mask;
+      keytable[j] = old[i];
+    }
+  }
+  DohFree(old);
+}
+
 /* Find or create a key in the interned key table */
 static DOH *find_key(DOH *doh_c) {
   char *c = (char *) doh_c;
-  KeyValue *r, *s;
-  int d = 0;
-  /* OK, sure, we use a binary tree for maintaining interned
-     symbols.  Then we use their hash values for accessing secondary
-     hash tables. */
-  r = root;
-  s = 0;
-  while (r) {
-    s = r;
-    d = strcmp(r->cstr, c);
-    if (d == 0)
+  unsigned int hv, mask, i;
+  KeyValue *r;
+  /* Interned keys live in an open addressing table (linear probing) keyed
+     by a hash of the C string. The hash is kept with each entry so that
+     probing only calls strcmp on a probable match. The interned String's
+     own hash value is then used for accessing secondary hash tables. */
+  if (2 * (keytable_nitems + 1) > keytable_size)
+    keytable_resize();
+  hv = key_hash(c);
+  mask = keytable_size - 1;
+  i = hv & mask;
+  while ((r = &keytable[i])->cstr) {
+    if (r->hashval == hv && strcmp(r->cstr, c) == 0)
       return r->sstr;
-    if (d < 0)
-      r = r->left;
-    else
-      r = r->right;
+    i = (i + 1) & mask;
   }
   /*  fprintf(stderr,"Interning '%s'\n", c); */
-  r = (KeyValue *) DohMalloc(sizeof(KeyValue));
   r->cstr = (char *) DohMalloc(strlen(c) + 1);
   strcpy(r->cstr, c);
+  r->hashval = hv;
   r->sstr = NewString(c);
   DohIntern(r->sstr);
-  r->left = 0;
-  r->right = 0;
-  if (!s) {
-    root = r;
-  } else {
-    if (d < 0)
-      s->left = r;
-    else
-      s->right = r;
-  }
+  keytable_nitems++;
   return r->sstr;
 }
 
-#define HASH_INIT_SIZE   7
+/* Number of slots at which a hash stops being a small, linearly searched array */
+#define HASH_SMALL_SIZE   16
+#define HASH_INIT_SIZE    4
+#define HASH_IS_SMALL(h)  ((h)->hashsize <= HASH_SMALL_SIZE)
+
+/* Marks a slot whose entry has been deleted */
+static char hash_deleted_key;
+#define HASH_DELETED      ((DOH *) &hash_deleted_key)
+#define HASH_LIVE(n)      ((n)->key && ((n)->key != HASH_DELETED))
+
+/* Scramble a key's hash value before masking it down to a table slot */
+static unsigned int slot_hash(int hv) {
+  unsigned int h = (unsigned int) hv;
+  h ^= h >> 16;
+  h *= 0x45d9f3bU;
+  h ^= h >> 16;
+  return h;
+}
 
-/* Create a new hash node */
-static HashNode *NewNode(DOH *k, void *obj) {
-  HashNode *hn = (HashNode *) DohMalloc(sizeof(HashNode));
-  hn->key = k;
-  Incref(hn->key);
-  hn->object = obj;
-  Incref(obj);
-  hn->next = 0;
-  return hn;
+/* Test whether the key in node n matches key k (with hash value hv) */
+static int key_match(HashNode *n, DOH *k, int hv) {
+  DohBase *nk = (DohBase *) n->key;
+  DohObjInfo *k_type;
+  /* Interned keys are shared, so a pointer match is the common case */
+  if (nk == (DohBase *) k)
+    return 1;
+  if ((n->hashval != hv) || (nk == (DohBase *) HASH_DELETED) || !nk)
+    return 0;
+  k_type = ((DohBase *) k)->type;
+  if (k_type != nk->type)
+    return 0;
+  if (k_type->doh_equal)
+    return k_type->doh_equal(k, nk);
+  return k_type->doh_cmp(k, nk) == 0;
+}
+
+/* Allocate an empty node array */
+static HashNode *NewNodes(int size) {
+  HashNode *table = (HashNode *) DohMalloc(size * sizeof(HashNode));
+  memset(table, 0, size * sizeof(HashNode));
+  return table;
+}
+
+/* Release the key and value held by a node */
+static void DelNode(HashNode *n) {
+  Delete(n->key);
+  Delete(n->object);
+}
+
+/* -----------------------------------------------------------------------------
+ * find_node()
+ *
+ * Return the node holding key k or 0 if there isn't one. Small hashes are a
+ * compact array kept in insertion order and searched linearly. Larger hashes
+ * use open addressing with linear probing over a power of 2 sized table.
+ * ----------------------------------------------------------------------------- */
+
+static HashNode *find_node(Hash *h, DOH *k, int hv) {
+  HashNode *n;
+  if (HASH_IS_SMALL(h)) {
+    HashNode *end = h->hashtable + h->nslots;
+    for (n = h->hashtable; n < end; n++) {
+      if (key_match(n, k, hv))
+	return n;
+    }
+  } else {
+    unsigned int mask = (unsigned int) h->hashsize - 1;
+    unsigned int i = slot_hash(hv) & mask;
+    while ((n = &h->hashtable[i])->key) {
+      if (key_match(n, k, hv))
+	return n;
+      i = (i + 1) & mask;
+    }
+  }
+  return 0;
 }
 
-/* Delete a hash node */
-static void DelNode(HashNode *hn) {
-  Delete(hn->key);
-  Delete(hn->object);
-  DohFree(hn);
+/* Place a node into a table known to have a free slot and no matching key */
+static HashNode *insert_node(Hash *h, DOH *k, DOH *obj, int hv) {
+  HashNode *n;
+  if (HASH_IS_SMALL(h)) {
+    n = &h->hashtable[h->nslots++];
+  } else {
+    unsigned int mask = (unsigned int) h->hashsize - 1;
+    unsigned int i = slot_hash(hv) & mask;
+    while (HASH_LIVE(&h->hashtable[i]))
+      i = (i + 1) & mask;
+    n = &h->hashtable[i];
+    if (!n->key)
+      h->nslots++;
+  }
+  n->key = k;
+  n->object = obj;
+  n->hashval = hv;
+  return n;
 }
 
 /* -----------------------------------------------------------------------------
@@ -109,16 +211,11 @@ static void DelNode(HashNode *hn) {
 
 static void DelHash(DOH *ho) {
   Hash *h = (Hash *) ObjData(ho);
-  HashNode *n, *next;
   int i;
 
   for (i = 0; i < h->hashsize; i++) {
-    n = h->hashtable[i];
-    while (n) {
-      next = n->next;
-      DelNode(n);
-      n = next;
-    }
+    if (HASH_LIVE(&h->hashtable[i]))
+      DelNode(&h->hashtable[i]);
   }
   DohFree(h->hashtable);
   h->hashtable = 0;
@@ -134,64 +231,70 @@ static void DelHash(DOH *ho) {
 
 static void Hash_clear(DOH *ho) {
   Hash *h = (Hash *) ObjData(ho);
-  HashNode *n, *next;
   int i;
 
   for (i = 0; i < h->hashsize; i++) {
-    n = h->hashtable[i];
-    while (n) {
-      next = n->next;
-      DelNode(n);
-      n = next;
-    }
-    h->hashtable[i] = 0;
+    if (HASH_LIVE(&h->hashtable[i]))
+      DelNode(&h->hashtable[i]);
   }
+  memset(h->hashtable, 0, h->hashsize * sizeof(HashNode));
   h->nitems = 0;
+  h->nslots = 0;
 }
 
-/* resize the hash table */
+/* -----------------------------------------------------------------------------
+ * resize()
+ *
+ * Make room for one more entry. A small hash grows its array until it holds
+ * HASH_SMALL_SIZE entries and is then promoted to an open addressing table,
+ * which is kept at most 2/3 full (deleted slots included).
+ * ----------------------------------------------------------------------------- */
+
 static void resize(Hash *h) {
-  HashNode *n, *next, **table;
-  int oldsize, newsize;
-  int i, p, hv;
-
-  if (h->nitems < 2 * h->hashsize)
-    return;
-
-  /* Too big. We have to rescale everything now */
-  oldsize = h->hashsize;
-
-  /* Calculate a new size */
-  newsize = 2 * oldsize + 1;
-  p = 3;
-  while (p < (newsize >> 1)) {
-    if (((newsize / p) * p) == newsize) {
-      newsize += 2;
-      p = 3;
-      continue;
-    }
-    p = p + 2;
-  }
+  HashNode *table = h->hashtable;
+  int oldsize = h->hashsize;
+  int newsize = oldsize;
+  int i;
 
-  table = (HashNode **) DohMalloc(newsize * sizeof(HashNode *));
-  for (i = 0; i < newsize; i++) {
-    table[i] = 0;
+  if (HASH_IS_SMALL(h)) {
+    if (h->nslots < oldsize)
+      return;
+    if (h->nitems < h->nslots) {
+      /* Squeeze out deleted entries, preserving insertion order */
+      int j = 0;
+      for (i = 0; i < h->nslots; i++) {
+	if (HASH_LIVE(&table[i]))
+	  table[j++] = table[i];
+      }
+      memset(table + j, 0, (oldsize - j) * sizeof(HashNode));
+      h->nslots = j;
+      return;
+    }
+    newsize = oldsize * 2;
+    if (newsize <= HASH_SMALL_SIZE) {
+      h->hashtable = (HashNode *) DohRealloc(table, newsize * sizeof(HashNode));
+      memset(h->hashtable + oldsize, 0, (newsize - oldsize) * sizeof(HashNode));
+      h->hashsize = newsize;
+      return;
+    }
+    /* Promote to an open addressing table */
+    newsize = HASH_SMALL_SIZE * 4;
+  } else {
+    if (3 * (h->nslots + 1) <= 2 * oldsize)
+      return;
+    /* Grow unless most of the used slots are merely deleted entries */
+    if (3 * (h->nitems + 1) > oldsize)
+      newsize = oldsize * 2;
   }
 
-  /* Walk down the old set of nodes and re-place */
+  h->hashtable = NewNodes(newsize);
   h->hashsize = newsize;
+  h->nslots = 0;
   for (i = 0; i < oldsize; i++) {
-    n = h->hashtable[i];
-    while (n) {
-      hv = Hashval(n->key) % newsize;
-      next = n->next;
-      n->next = table[hv];
-      table[hv] = n;
-      n = next;
-    }
+    if (HASH_LIVE(&table[i]))
+      insert_node(h, table[i].key, table[i].object, table[i].hashval);
   }
-  DohFree(h->hashtable);
-  h->hashtable = table;
+  DohFree(table);
 }
 
 /* -----------------------------------------------------------------------------
@@ -203,7 +306,7 @@ static void resize(Hash *h) {
 
 static int Hash_setattr(DOH *ho, DOH *k, DOH *obj) {
   int hv;
-  HashNode *n, *prev;
+  HashNode *n;
   Hash *h = (Hash *) ObjData(ho);
 
   if (!obj) {
@@ -215,33 +318,25 @@ static int Hash_setattr(DOH *ho, DOH *k, DOH *obj) {
     obj = NewString((char *) obj);
     Decref(obj);
   }
-  hv = (Hashval(k)) % h->hashsize;
-  n = h->hashtable[hv];
-  prev = 0;
-  while (n) {
-    if (Cmp(n->key, k) == 0) {
-      /* Node already exists.  Just replace its contents */
-      if (n->object == obj) {
-	/* Whoa. Same object.  Do nothing */
-	return 1;
-      }
-      Delete(n->object);
-      n->object = obj;
-      Incref(obj);
-      return 1;			/* Return 1 to indicate a replacement */
-    } else {
-      prev = n;
-      n = n->next;
+  hv = Hashval(k);
+  n = find_node(h, k, hv);
+  if (n) {
+    /* Node already exists.  Just replace its contents */
+    if (n->object == obj) {
+      /* Whoa. Same object.  Do nothing */
+      return 1;
     }
+    Delete(n->object);
+    n->object = obj;
+    Incref(obj);
+    return 1;			/* Return 1 to indicate a replacement */
   }
   /* Add this to the table */
-  n = NewNode(k, obj);
-  if (prev)
-    prev->next = n;
-  else
-    h->hashtable[hv] = n;
-  h->nitems++;
   resize(h);
+  Incref(k);
+  Incref(obj);
+  insert_node(h, k, obj, hv);
+  h->nitems++;
   return 0;
 }
 
@@ -250,69 +345,57 @@ static int Hash_setattr(DOH *ho, DOH *k, DOH *obj) {
  *
  * Get an attribute from the hash table. Returns 0 if it doesn't exist.
  * ----------------------------------------------------------------------------- */
-typedef int (*binop) (DOH *obj1, DOH *obj2);
-
 
 static DOH *Hash_getattr(DOH *h, DOH *k) {
-  DOH *obj = 0;
   Hash *ho = (Hash *) ObjData(h);
   DOH *ko = DohCheck(k) ? k : find_key(k);
-  int hv = Hashval(ko) % ho->hashsize;
-  DohObjInfo *k_type = ((DohBase*)ko)->type;
-  HashNode *n = ho->hashtable[hv];
-  if (k_type->doh_equal) {
-    binop equal = k_type->doh_equal;
-    while (n) {
-      DohBase *nk = (DohBase *)n->key;
-      if ((k_type == nk->type) && equal(ko, nk)) obj = n->object;
-      n = n->next;
-    }
-  } else {
-    binop cmp = k_type->doh_cmp;
-    while (n) {
-      DohBase *nk = (DohBase *)n->key;
-      if ((k_type == nk->type) && (cmp(ko, nk) == 0)) obj = n->object;
-      n = n->next;
-    }
-  }
-  return obj;
+  HashNode *n = find_node(ho, ko, Hashval(ko));
+  return n ? n->object : 0;
 }
 
 /* -----------------------------------------------------------------------------
  * Hash_delattr()
  *
- * Delete an object from the hash table.
+ * Delete an object from the hash table. The slot is marked as deleted rather
+ * than emptied so that probe sequences and active iterators remain valid.
  * ----------------------------------------------------------------------------- */
 
 static int Hash_delattr(DOH *ho, DOH *k) {
-  HashNode *n, *prev;
-  int hv;
+  HashNode *n;
   Hash *h = (Hash *) ObjData(ho);
 
   if (!DohCheck(k))
     k = find_key(k);
-  hv = Hashval(k) % h->hashsize;
-  n = h->hashtable[hv];
-  prev = 0;
-  while (n) {
-    if (Cmp(n->key, k) == 0) {
-      /* Found it, kill it */
-
-      if (prev) {
-	prev->next = n->next;
-      } else {
-	h->hashtable[hv] = n->next;
-      }
-      DelNode(n);
-      h->nitems--;
-      return 1;
-    }
-    prev = n;
-    n = n->next;
+  n = find_node(h, k, Hashval(k));
+  if (!n)
+    return 0;
+
+  /* Found it, kill it */
+  DelNode(n);
+  n->key = HASH_DELETED;
+  n->object = 0;
+  h->nitems--;
+  return 1;
+}
+
+/* Advance iter to the first live slot at or after iter._index */
+static DohIterator hash_iter_seek(Hash *h, DohIterator iter) {
+  while ((iter._index < h->hashsize) && !HASH_LIVE(&h->hashtable[iter._index]))
+    iter._index++;
+
+  if (iter._index >= h->hashsize) {
+    iter.item = 0;
+    iter.key = 0;
+    return iter;
   }
-  return 0;
+  iter.key = h->hashtable[iter._index].key;
+  iter.item = h->hashtable[iter._index].object;
+  return iter;
 }
 
+/* Iteration walks the slots in order. As deleted entries only leave a marker
+   behind, the item being iterated over can be deleted without trashing the
+   universe */
 static DohIterator Hash_firstiter(DOH *ho) {
   DohIterator iter;
   Hash *h = (Hash *) ObjData(ho);
@@ -321,43 +404,13 @@ static DohIterator Hash_firstiter(DOH *ho) {
   iter.item = 0;
   iter.key = 0;
   iter._index = 0;		/* Index in hash table */
-  while ((iter._index < h->hashsize) && !h->hashtable[iter._index])
-    iter._index++;
-
-  if (iter._index >= h->hashsize) {
-    return iter;
-  }
-  iter._current = h->hashtable[iter._index];
-  iter.item = ((HashNode *) iter._current)->object;
-  iter.key = ((HashNode *) iter._current)->key;
-
-  /* Actually save the next slot in the hash.  This makes it possible to
-     delete the item being iterated over without trashing the universe */
-  iter._current = ((HashNode *) iter._current)->next;
-  return iter;
+  return hash_iter_seek(h, iter);
 }
 
 static DohIterator Hash_nextiter(DohIterator iter) {
   Hash *h = (Hash *) ObjData(iter.object);
-  if (!iter._current) {
-    iter._index++;
-    while ((iter._index < h->hashsize) && !h->hashtable[iter._index]) {
-      iter._index++;
-    }
-    if (iter._index >= h->hashsize) {
-      iter.item = 0;
-      iter.key = 0;
-      iter._current = 0;
-      return iter;
-    }
-    iter._current = h->hashtable[iter._index];
-  }
-  iter.key = ((HashNode *) iter._current)->key;
-  iter.item = ((HashNode *) iter._current)->object;
-
-  /* Store the next node to iterator on */
-  iter._current = ((HashNode *) iter._current)->next;
-  return iter;
+  iter._index++;
+  return hash_iter_seek(h, iter);
 }
 
 /* -----------------------------------------------------------------------------
@@ -419,12 +472,8 @@ static DOH *Hash_str(DOH *ho) {
   if (expanded >= max_expand) {
     /* replace each hash attribute with a '.' */
     Printf(s, "Hash(%p) {", ho);
-    for (i = 0; i < h->hashsize; i++) {
-      n = h->hashtable[i];
-      while (n) {
-	Putc('.', s);
-	n = n->next;
-      }
+    for (i = 0; i < h->nitems; i++) {
+      Putc('.', s);
     }
     Putc('}', s);
     return s;
@@ -432,14 +481,13 @@ static DOH *Hash_str(DOH *ho) {
   ObjSetMark(ho, 1);
   Printf(s, "Hash(%p) {\n", ho);
   for (i = 0; i < h->hashsize; i++) {
-    n = h->hashtable[i];
-    while (n) {
+    n = &h->hashtable[i];
+    if (HASH_LIVE(n)) {
       for (j = 0; j < expanded + 1; j++)
 	Printf(s, tab);
       expanded += 1;
       Printf(s, "'%s' : %s, \n", n->key, n->object);
       expanded -= 1;
-      n = n->next;
     }
   }
   for (j = 0; j < expanded; j++)
@@ -469,31 +517,31 @@ static int Hash_len(DOH *ho) {
 static DOH *CopyHash(DOH *ho) {
   Hash *h, *nh;
   HashNode *n;
-  DOH *nho;
-
   int i;
+
   h = (Hash *) ObjData(ho);
   nh = (Hash *) DohMalloc(sizeof(Hash));
   nh->hashsize = h->hashsize;
-  nh->hashtable = (HashNode **) DohMalloc(nh->hashsize * sizeof(HashNode *));
-  for (i = 0; i < nh->hashsize; i++) {
-    nh->hashtable[i] = 0;
-  }
+  nh->hashtable = NewNodes(nh->hashsize);
   nh->nitems = 0;
+  nh->nslots = 0;
   nh->line = h->line;
   nh->file = h->file;
   if (nh->file)
     Incref(nh->file);
 
-  nho = DohObjMalloc(&DohHashType, nh);
+  /* Keys are already unique and the table is the same size, so the nodes can
+     be placed directly without any lookups */
   for (i = 0; i < h->hashsize; i++) {
-    n = h->hashtable[i];
-    while (n) {
-      Hash_setattr(nho, n->key, n->object);
-      n = n->next;
+    n = &h->hashtable[i];
+    if (HASH_LIVE(n)) {
+      Incref(n->key);
+      Incref(n->object);
+      insert_node(nh, n->key, n->object, n->hashval);
+      nh->nitems++;
     }
   }
-  return nho;
+  return DohObjMalloc(&DohHashType, nh);
 }
 
 
@@ -572,14 +620,11 @@ DohObjInfo DohHashType = {
 
 DOH *DohNewHash(void) {
   Hash *h;
-  int i;
   h = (Hash *) DohMalloc(sizeof(Hash));
   h->hashsize = HASH_INIT_SIZE;
-  h->hashtable = (HashNode **) DohMalloc(h->hashsize * sizeof(HashNode *));
-  for (i = 0; i < h->hashsize; i++) {
-    h->hashtable[i] = 0;
-  }
+  h->hashtable = NewNodes(h->hashsize);
   h->nitems = 0;
+  h->nslots = 0;
   h->file = 0;
   h->line = 0;
   return DohObjMalloc(&DohHashType, h);
@@ -39,6 +39,9 @@ typedef struct pool {
 
 static DohBase *FreeList = 0;	/* List of free objects */
 static Pool *Pools = 0;
+static Pool **PoolIndex = 0;	/* Pools sorted by address, for DohCheck() */
+static int pool_count = 0;
+static int pool_max = 0;
 static int pools_initialized = 0;
 
 /* ----------------------------------------------------------------------
@@ -47,6 +50,7 @@ static int pools_initialized = 0;
 
 static void CreatePool() {
   Pool *p = 0;
+  int i;
   p = (Pool *) DohMalloc(sizeof(Pool));
   assert(p);
   p->ptr = (DohBase *) DohMalloc(sizeof(DohBase) * PoolSize);
@@ -59,6 +63,19 @@ static void CreatePool() {
   p->pend = p->pbeg + p->blen;
   p->next = Pools;
   Pools = p;
+
+  if (pool_count == pool_max) {
+    pool_max = pool_max ? pool_max * 2 : 64;
+    PoolIndex = (Pool **) DohRealloc(PoolIndex, pool_max * sizeof(Pool *));
+    assert(PoolIndex);
+  }
+  i = pool_count;
+  while (i > 0 && PoolIndex[i - 1]->pbeg > p->pbeg) {
+    PoolIndex[i] = PoolIndex[i - 1];
+    i--;
+  }
+  PoolIndex[i] = p;
+  pool_count++;
 }
 
 /* ----------------------------------------------------------------------
@@ -81,10 +98,18 @@ static void InitPools() {
  * ---------------------------------------------------------------------- */
 
 int DohCheck(const DOH *ptr) {
-  register Pool *p = Pools;
   register char *cptr = (char *) ptr;
-  while (p) {
-    if ((cptr >= p->pbeg) && (cptr < p->pend)) {
+  register int lo = 0;
+  register int hi = pool_count - 1;
+  /* Binary search as many pools are needed for large interfaces */
+  while (lo <= hi) {
+    int mid = (lo + hi) / 2;
+    Pool *p = PoolIndex[mid];
+    if (cptr < p->pbeg) {
+      hi = mid - 1;
+    } else if (cptr >= p->pend) {
+      lo = mid + 1;
+    } else {
 #ifdef DOH_DEBUG_MEMORY_POOLS
       DohBase *b = (DohBase *) ptr;
       int DOH_object_already_deleted = b->type == 0;
@@ -92,10 +117,6 @@ int DohCheck(const DOH *ptr) {
 #endif
       return 1;
     }
-    /*
-       pptr = (char *) p->ptr;
-       if ((cptr >= pptr) && (cptr < (pptr+(p->current*sizeof(DohBase))))) return 1; */
-    p = p->next;
   }
   return 0;
 }
@@ -164,6 +185,191 @@ void DohObjFree(DOH *ptr) {
   }
 }
 
+/* ----------------------------------------------------------------------
+ * Arena allocation
+ *
+ * When enabled with DohSetMemoryArena(), the payload of every object
+ * (string buffers, hash tables, list arrays...) is carved out of large
+ * chunks with a bump pointer instead of going through malloc/free.
+ * Memory is only given back to the system when the process exits, so
+ * teardown of the object graph costs nothing. Each block is preceded by its
+ * size so that it can be reallocated. Freed small blocks are kept on per
+ * size free lists for reuse; larger freed blocks are simply abandoned.
+ * ---------------------------------------------------------------------- */
+
+#ifndef DOH_ARENA_SIZE
+#define DOH_ARENA_SIZE        (4*1024*1024)
+#endif
+
+typedef union arenaheader {
+  size_t size;			/* Size of the block that follows */
+  double align_d;
+  void *align_p;
+} ArenaHeader;
+
+typedef struct arena {
+  char *pbeg;			/* Beg of arena */
+  char *pend;			/* End of arena */
+  char *current;		/* Position for next allocation */
+} Arena;
+
+static int arena_enabled = 0;
+static Arena **Arenas = 0;	/* Arenas sorted by address */
+static int arena_count = 0;
+static int arena_max = 0;
+static Arena *arena_current = 0;	/* Arena bump allocations come from */
+static size_t arena_allocated = 0;	/* Bytes handed out, including headers */
+static size_t arena_released = 0;	/* Bytes freed or left behind by a reallocation */
+static int arena_nallocs = 0;
+
+#define DOH_ARENA_NFREE       64	/* Number of free lists, one per multiple of the header size */
+static void *arena_freelist[DOH_ARENA_NFREE];
+
+/* ----------------------------------------------------------------------
+ * DohSetMemoryArena()
+ *
+ * Turns arena allocation on or off for subsequent payload allocations.
+ * It should be enabled before any objects are created, although memory
+ * obtained from malloc beforehand is still handled correctly.
+ * ---------------------------------------------------------------------- */
+
+void DohSetMemoryArena(int enable) {
+  arena_enabled = enable;
+}
+
+/* Find the arena containing ptr, if any */
+static Arena *arena_find(const void *ptr) {
+  const char *cptr = (const char *) ptr;
+  int lo = 0;
+  int hi = arena_count - 1;
+  while (lo <= hi) {
+    int mid = (lo + hi) / 2;
+    Arena *a = Arenas[mid];
+    if (cptr < a->pbeg)
+      hi = mid - 1;
+    else if (cptr >= a->pend)
+      lo = mid + 1;
+    else
+      return a;
+  }
+  return 0;
+}
+
+/* Add a new arena of at least size bytes, keeping Arenas sorted by address */
+static Arena *arena_create(size_t size) {
+  Arena *a;
+  int i;
+  if (arena_count == arena_max) {
+    arena_max = arena_max ? arena_max * 2 : 64;
+    Arenas = (Arena **) realloc(Arenas, arena_max * sizeof(Arena *));
+    assert(Arenas);
+  }
+  a = (Arena *) malloc(sizeof(Arena));
+  assert(a);
+  a->pbeg = (char *) malloc(size);
+  assert(a->pbeg);
+  a->pend = a->pbeg + size;
+  a->current = a->pbeg;
+  i = arena_count;
+  while (i > 0 && Arenas[i - 1]->pbeg > a->pbeg) {
+    Arenas[i] = Arenas[i - 1];
+    i--;
+  }
+  Arenas[i] = a;
+  arena_count++;
+  return a;
+}
+
+static void *arena_malloc(size_t size) {
+  ArenaHeader *h;
+  size_t units = size ? (size + sizeof(ArenaHeader) - 1) / sizeof(ArenaHeader) : 1;
+  size_t need = (units + 1) * sizeof(ArenaHeader);
+  Arena *a;
+
+  if (units < DOH_ARENA_NFREE && arena_freelist[units]) {
+    void *ptr = arena_freelist[units];
+    arena_freelist[units] = *((void **) ptr);
+    arena_released -= need;
+    return ptr;
+  }
+
+  if (need > DOH_ARENA_SIZE / 4) {
+    /* Large blocks get an arena of their own */
+    a = arena_create(need);
+  } else {
+    if (!arena_current || (size_t) (arena_current->pend - arena_current->current) < need) {
+      arena_current = arena_create(DOH_ARENA_SIZE);
+    }
+    a = arena_current;
+  }
+  h = (ArenaHeader *) a->current;
+  h->size = need - sizeof(ArenaHeader);
+  a->current += need;
+  arena_allocated += need;
+  arena_nallocs++;
+  return (void *) (h + 1);
+}
+
+/* ----------------------------------------------------------------------
+ * DohMemMalloc(), DohMemRealloc(), DohMemFree()
+ *
+ * Allocators for the payload of objects. These are plain malloc, realloc
+ * and free unless arena allocation has been turned on.
+ * ---------------------------------------------------------------------- */
+
+void *DohMemMalloc(size_t size) {
+  if (!arena_enabled)
+    return malloc(size);
+  return arena_malloc(size);
+}
+
+void *DohMemRealloc(void *ptr, size_t size) {
+  ArenaHeader *h;
+  Arena *a;
+  void *nptr;
+
+  if (!ptr)
+    return DohMemMalloc(size);
+  a = arena_count ? arena_find(ptr) : 0;
+  if (!a) {
+    /* Not arena memory, possibly obtained before the arena was turned on */
+    return realloc(ptr, size);
+  }
+  h = (ArenaHeader *) ptr - 1;
+  if (size <= h->size)
+    return ptr;
+  if (a == arena_current && (char *) ptr + h->size == a->current) {
+    /* Last block in the current arena, so grow it in place if there is room */
+    size_t extra = (size - h->size + sizeof(ArenaHeader) - 1) / sizeof(ArenaHeader) * sizeof(ArenaHeader);
+    if ((size_t) (a->pend - a->current) >= extra) {
+      a->current += extra;
+      h->size += extra;
+      arena_allocated += extra;
+      return ptr;
+    }
+  }
+  nptr = arena_malloc(size);
+  memcpy(nptr, ptr, h->size);
+  DohMemFree(ptr);
+  return nptr;
+}
+
+void DohMemFree(void *ptr) {
+  size_t units;
+  if (!ptr)
+    return;
+  if (!arena_count || !arena_find(ptr)) {
+    free(ptr);
+    return;
+  }
+  units = ((ArenaHeader *) ptr - 1)->size / sizeof(ArenaHeader);
+  arena_released += (units + 1) * sizeof(ArenaHeader);
+  if (units < DOH_ARENA_NFREE) {
+    *((void **) ptr) = arena_freelist[units];
+    arena_freelist[units] = ptr;
+  }
+}
+
 /* ----------------------------------------------------------------------
  * DohMemoryDebug()
  *
@@ -218,6 +424,21 @@ void DohMemoryDebug(void) {
   printf("    Lists     : %d\n", numlist);
   printf("    Hashes    : %d\n", numhash);
 
+  if (arena_count) {
+    size_t capacity = 0;
+    size_t live = arena_allocated - arena_released;
+    int i;
+    for (i = 0; i < arena_count; i++)
+      capacity += (size_t) (Arenas[i]->pend - Arenas[i]->pbeg);
+    printf("\nArenas (%s)\n", arena_enabled ? "enabled" : "disabled");
+    printf("    Arenas    : %d\n", arena_count);
+    printf("    Capacity  : %lu bytes\n", (unsigned long) capacity);
+    printf("    Allocated : %lu bytes in %d blocks (%.1f%% of capacity)\n", (unsigned long) arena_allocated, arena_nallocs,
+	   capacity ? 100.0 * (double) arena_allocated / (double) capacity : 0.0);
+    printf("    Released  : %lu bytes (freed, awaiting reuse or abandoned)\n", (unsigned long) arena_released);
+    printf("    Live      : %lu bytes (%.1f%% of capacity)\n", (unsigned long) live, capacity ? 100.0 * (double) live / (double) capacity : 0.0);
+  }
+
 #if 0
   p = Pools;
   while (p) {
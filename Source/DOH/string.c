@@ -180,19 +180,14 @@ static int String_hash(DOH *so) {
   if (s->hashkey >= 0) {
     return s->hashkey;
   } else {
-    register char *c = s->str;
-    register unsigned int len = s->len > 50 ? 50 : s->len;
-    register unsigned int h = 0;
-    register unsigned int mlen = len >> 2;
-    register unsigned int i = mlen;
-    for (; i; --i) {
-      h = (h << 5) + *(c++);
-      h = (h << 5) + *(c++);
-      h = (h << 5) + *(c++);
-      h = (h << 5) + *(c++);
-    }
-    for (i = len - (mlen << 2); i; --i) {
-      h = (h << 5) + *(c++);
+    /* FNV-1a over the whole string. Keys such as scoped type names often only
+       differ near the end, so hashing a prefix leads to long collision chains. */
+    register const unsigned char *c = (const unsigned char *) s->str;
+    register const unsigned char *end = c + s->len;
+    register unsigned int h = 2166136261U;
+    while (c < end) {
+      h ^= *(c++);
+      h *= 16777619U;
     }
     h &= 0x7fffffff;
     s->hashkey = (int)h;
@@ -1074,7 +1069,7 @@ DOHString *DohNewString(const DOHString_or_char *so) {
 DOHString *DohNewStringEmpty(void) {
   int max = INIT_MAXSIZE;
   String *str = (String *) DohMalloc(sizeof(String));
-  str->hashkey = 0;
+  str->hashkey = -1;
   str->sp = 0;
   str->line = 1;
   str->file = 0;
@@ -283,6 +283,7 @@
 #define WARN_CSHARP_EXCODE                    844
 #define WARN_CSHARP_CANTHROW                  845
 #define WARN_CSHARP_NO_DIRECTORCONNECT_ATTR   846
+#define WARN_CSHARP_SUPPRESSGCTRANSITION      847
 
 /* please leave 830-849 free for C# */
 
@@ -45,6 +45,7 @@ class CSHARP:public Language {
   bool wrapping_member_flag;	// Flag for when wrapping a member variable/enum/const
   bool global_variable_flag;	// Flag for when wrapping a global variable
   bool old_variable_names;	// Flag for old style variable names in the intermediary class
+  bool fast_pinvoke_flag;	// Flag for generating blittable intermediary class signatures
   bool generate_property_declaration_flag;	// Flag for generating properties
 
   String *imclass_name;		// intermediary class name
@@ -121,6 +122,7 @@ public:
       wrapping_member_flag(false),
       global_variable_flag(false),
       old_variable_names(false),
+      fast_pinvoke_flag(false),
       generate_property_declaration_flag(false),
       imclass_name(NULL),
       module_class_name(NULL),
@@ -254,6 +256,9 @@ public:
 	} else if (strcmp(argv[i], "-oldvarnames") == 0) {
 	  Swig_mark_arg(i);
 	  old_variable_names = true;
+	} else if (strcmp(argv[i], "-fastpinvoke") == 0) {
+	  Swig_mark_arg(i);
+	  fast_pinvoke_flag = true;
 	} else if (strcmp(argv[i], "-outfile") == 0) {
 	  if (argv[i + 1]) {
 	    output_file = NewString("");
@@ -272,6 +277,8 @@ public:
 
     // Add a symbol to the parser for conditional compilation
     Preprocessor_define("SWIGCSHARP 1", 0);
+    if (fast_pinvoke_flag)
+      Preprocessor_define("SWIG_CSHARP_FASTPINVOKE 1", 0);
 
     // Add typemap definitions
     SWIG_typemap_lang("csharp");
@@ -338,9 +345,9 @@ public:
     }
 
     f_runtime = NewString("");
-    f_init = NewString("");
+    f_init = Swig_new_section();
     f_header = NewString("");
-    f_wrappers = NewString("");
+    f_wrappers = Swig_new_section();
     f_directors_h = NewString("");
     f_directors = NewString("");
 
@@ -847,6 +854,7 @@ public:
     }
 
     Printv(imclass_class_code, "\n  [global::System.Runtime.InteropServices.DllImport(\"", dllimport, "\", EntryPoint=\"", wname, "\")]\n", NIL);
+    int im_attributes_position = Len(imclass_class_code);
 
     if (im_outattributes)
       Printf(imclass_class_code, "  %s\n", im_outattributes);
@@ -1055,15 +1063,30 @@ public:
     if (!native_function_flag) {
       Wrapper_print(f, f_wrappers);
 
-      // Handle %csexception which sets the canthrow attribute
-      if (Getattr(n, "feature:except:canthrow"))
+      // Handle %csexception which sets the canthrow attribute. With -fastpinvoke the
+      // exception handler is assumed not to be entered for functions declared not to throw.
+      bool nothrow_handler = fast_pinvoke_flag && isNothrow(n);
+      if (Getattr(n, "feature:except:canthrow") && !nothrow_handler)
 	Setattr(n, "csharp:canthrow", "1");
 
+      // SuppressGCTransition is only safe if the unmanaged code cannot call back into managed code
+      if (GetFlag(n, "feature:cs:suppressgctransition")) {
+	if (!fast_pinvoke_flag) {
+	  Swig_warning(WARN_CSHARP_SUPPRESSGCTRANSITION, input_file, line_number,
+		       "Ignoring the cs:suppressgctransition feature for %s as it requires the -fastpinvoke option.\n", Swig_name_decl(n));
+	} else if (canCallManagedCode(n, f->code, nothrow_handler)) {
+	  Swig_warning(WARN_CSHARP_SUPPRESSGCTRANSITION, input_file, line_number,
+		       "Ignoring the cs:suppressgctransition feature for %s as the unmanaged code can call back into C#.\n", Swig_name_decl(n));
+	} else {
+	  Insert(imclass_class_code, im_attributes_position, "  [global::System.Runtime.InteropServices.SuppressGCTransition]\n");
+	}
+      }
+
       // A very simple check (it is not foolproof) to help typemap/feature writers for
       // throwing C# exceptions from unmanaged code. It checks for the common methods which
       // set a pending C# exception... the 'canthrow' typemap/feature attribute must be set
       // so that code which checks for pending exceptions is added in the C# proxy method.
-      if (!Getattr(n, "csharp:canthrow")) {
+      if (!Getattr(n, "csharp:canthrow") && !nothrow_handler) {
 	if (Strstr(f->code, "SWIG_exception")) {
 	  Swig_warning(WARN_CSHARP_CANTHROW, input_file, line_number,
 		       "Unmanaged code contains a call to SWIG_exception and C# code does not handle pending exceptions via the canthrow attribute.\n");
@@ -3555,6 +3578,36 @@ public:
     Delete(canthrow_attribute);
   }
 
+  /* -----------------------------------------------------------------------------
+   * isNothrow()
+   *
+   * Returns true if the function is declared noexcept or with an empty exception
+   * specification, that is, throw().
+   * ----------------------------------------------------------------------------- */
+
+  bool isNothrow(Node *n) {
+    String *nexcept = Getattr(n, "noexcept");
+    if (nexcept)
+      return Equal(nexcept, "true") || Equal(nexcept, "1");
+    return Getattr(n, "throw") && !Getattr(n, "throws");
+  }
+
+  /* -----------------------------------------------------------------------------
+   * canCallManagedCode()
+   *
+   * Returns true if the wrapper code for a function may call back into C#, either
+   * to throw a C# exception, via a director upcall or to create a C# string.
+   * ----------------------------------------------------------------------------- */
+
+  bool canCallManagedCode(Node *n, const String *code, bool nothrow_handler) {
+    if (Getattr(n, "csharp:canthrow") || (is_wrapping_class() && Swig_directorclass(getCurrentClass())))
+      return true;
+    if (Strstr(code, "SWIG_csharp_string_callback") || Strstr(code, "SWIG_csharp_wstring_callback"))
+      return true;
+    // Pending exceptions set in the %exception handler are ignored for functions that cannot throw
+    return !nothrow_handler && (Strstr(code, "SWIG_exception") || Strstr(code, "SWIG_CSharpSetPendingException"));
+  }
+
   /* -----------------------------------------------------------------------------
    * excodeSubstitute()
    * If a method can throw a C# exception, additional exception code is added to
@@ -4540,6 +4593,9 @@ extern "C" Language *swig_csharp(void) {
 const char *CSHARP::usage = "\
 C# Options (available with -csharp)\n\
      -dllimport <dl> - Override DllImport attribute name to <dl>\n\
+     -fastpinvoke    - Generate blittable intermediary class signatures for bool and\n\
+                       const char * parameters and skip the pending exception check\n\
+                       for functions declared noexcept or throw()\n\
      -namespace <nm> - Generate wrappers into C# namespace <nm>\n\
      -noproxy        - Generate the low-level functional interface instead\n\
                        of proxy classes\n\
@@ -369,9 +369,9 @@ public:
     }
 
     f_runtime = NewString("");
-    f_init = NewString("");
+    f_init = Swig_new_section();
     f_header = NewString("");
-    f_wrappers = NewString("");
+    f_wrappers = Swig_new_section();
     f_directors_h = NewString("");
     f_directors = NewString("");
 
@@ -719,10 +719,11 @@ public:
     n_dmethods = 0;
 
     /* Close all of the files */
-    Dump(f_header, f_runtime);
+    Dump(f_runtime, f_begin);
+    Dump(f_header, f_begin);
 
     if (directorsEnabled()) {
-      Dump(f_directors, f_runtime);
+      Dump(f_directors, f_begin);
       Dump(f_directors_h, f_runtime_h);
 
       Printf(f_runtime_h, "\n");
@@ -736,12 +737,11 @@ public:
       f_directors_h = NULL;
     }
 
-    Dump(f_wrappers, f_runtime);
-    Wrapper_pretty_print(f_init, f_runtime);
+    Dump(f_wrappers, f_begin);
+    Wrapper_pretty_print(f_init, f_begin);
     Delete(f_header);
     Delete(f_wrappers);
     Delete(f_init);
-    Dump(f_runtime, f_begin);
     Delete(f_runtime);
     Delete(f_begin);
     return SWIG_OK;
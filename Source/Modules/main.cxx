@@ -77,12 +77,14 @@ static const char *usage1 = (const char *) "\
      -debug-template - Display information for debugging templates\n\
      -debug-top <n>  - Display entire parse tree at stages 1-4, <n> is a csv list of stages\n\
      -debug-typedef  - Display information about the types and typedefs in the interface\n\
+     -debug-typesys-stats - Display typedef resolution cache statistics\n\
      -debug-typemap  - Display typemap debugging information\n\
      -debug-tmsearch - Display typemap search debugging information\n\
      -debug-tmused   - Display typemaps used debugging information\n\
      -directors      - Turn on director mode for all the classes, mainly for testing\n\
      -dirprot        - Turn on wrapping of protected members for director classes (default)\n\
      -D<symbol>      - Define a symbol <symbol> (for conditional compilation)\n\
+     -doh-arena      - Allocate memory for objects from arenas and skip freeing it on exit\n\
 ";
 
 static const char *usage2 = (const char *) "\
@@ -137,7 +139,9 @@ static const char *usage4 = (const char *) "\
      -outcurrentdir  - Set default output dir to current dir instead of input file's path\n\
      -outdir <dir>   - Set language specific files output directory to <dir>\n\
      -pcreversion    - Display PCRE version information\n\
+     -ppcache <dir>  - Cache the preprocessed SWIG library files in <dir>\n\
      -small          - Compile in virtual elimination & compact mode\n\
+     -spill          - Buffer the wrapper and init code in temporary files to reduce memory use\n\
      -swiglib        - Report location of SWIG library and exit\n\
      -templatereduce - Reduce all the typedefs in templates\n\
      -v              - Run in verbose mode\n\
@@ -169,6 +173,7 @@ static int freeze = 0;
 static String *lang_config = 0;
 static const char *hpp_extension = "h";
 static const char *cpp_extension = "cxx";
+static const char *wrap_suffix = "_wrap";
 static const char *depends_extension = "d";
 static String *outdir = 0;
 static String *xmlout = 0;
@@ -180,6 +185,8 @@ static int no_cpp = 0;
 static String *outfile_name = 0;
 static String *outfile_name_h = 0;
 static int tm_debug = 0;
+static int tm_search_debug = 0;
+static int typesys_stats = 0;
 static int dump_symtabs = 0;
 static int dump_symbols = 0;
 static int dump_csymbols = 0;
@@ -196,6 +203,7 @@ static int depend = 0;
 static int depend_only = 0;
 static int depend_phony = 0;
 static int memory_debug = 0;
+static int doh_arena = 0;
 static int allkw = 0;
 static DOH *cpps = 0;
 static String *dependencies_file = 0;
@@ -334,6 +342,11 @@ void SWIG_config_cppext(const char *ext) {
   cpp_extension = ext;
 }
 
+/* Sets the suffix added to the input file's base name for the default output file names */
+void SWIG_config_wrap_suffix(const char *suffix) {
+  wrap_suffix = suffix;
+}
+
 List *SWIG_output_files() {
   assert(all_output_files);
   return all_output_files;
@@ -530,6 +543,9 @@ void SWIG_getoptions(int argc, char *argv[]) {
 	Wrapper_compact_print_mode_set(1);
 	Wrapper_virtual_elimination_mode_set(1);
 	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-spill") == 0) {
+	Swig_spill_sections_set(1);
+	Swig_mark_arg(i);
       } else if (strcmp(argv[i], "-runtime") == 0) { // Used to also accept -c. removed in swig-1.3.36
 	Swig_mark_arg(i);
 	Swig_warning(WARN_DEPRECATED_OPTC, "SWIG", 1, "-runtime, -noruntime command line options are deprecated.\n");
@@ -698,6 +714,7 @@ void SWIG_getoptions(int argc, char *argv[]) {
 	Swig_mark_arg(i);
       } else if (strcmp(argv[i], "-debug-tmsearch") == 0) {
 	Swig_typemap_search_debug_set();
+	tm_search_debug = 1;
 	Swig_mark_arg(i);
       } else if (strcmp(argv[i], "-debug-tmused") == 0) {
 	Swig_typemap_used_debug_set();
@@ -757,6 +774,14 @@ void SWIG_getoptions(int argc, char *argv[]) {
       } else if (strcmp(argv[i], "-outcurrentdir") == 0) {
 	Swig_mark_arg(i);
 	outcurrentdir = 1;
+      } else if (strcmp(argv[i], "-ppcache") == 0) {
+	Swig_mark_arg(i);
+	if (argv[i + 1]) {
+	  Preprocessor_cache_dir(argv[i + 1]);
+	  Swig_mark_arg(i + 1);
+	} else {
+	  Swig_arg_error();
+	}
       } else if (strcmp(argv[i], "-Wall") == 0) {
 	Swig_mark_arg(i);
 	Swig_warnall();
@@ -843,6 +868,9 @@ void SWIG_getoptions(int argc, char *argv[]) {
       } else if (strcmp(argv[i], "-browse") == 0) {
 	browse = 1;
 	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-debug-typesys-stats") == 0) {
+	typesys_stats = 1;
+	Swig_mark_arg(i);
       } else if ((strcmp(argv[i], "-debug-typedef") == 0) || (strcmp(argv[i], "-dump_typedef") == 0)) {
 	dump_typedef = 1;
 	Swig_mark_arg(i);
@@ -852,6 +880,10 @@ void SWIG_getoptions(int argc, char *argv[]) {
       } else if ((strcmp(argv[i], "-debug-memory") == 0) || (strcmp(argv[i], "-dump_memory") == 0)) {
 	memory_debug = 1;
 	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-doh-arena") == 0) {
+	// Already turned on in main() before any DOH objects were created
+	doh_arena = 1;
+	Swig_mark_arg(i);
       } else if (strcmp(argv[i], "-Fstandard") == 0) {
 	Swig_error_msg_format(EMF_STANDARD);
 	Swig_mark_arg(i);
@@ -1068,20 +1100,28 @@ int SWIG_main(int argc, char *argv[], Language *l) {
 	}
       }
       if (!no_cpp) {
+	/* The library files ahead of the input file are the same for every input file, so their preprocessed output can be cached */
+	String *libfs = NewString("");
+	String *rest;
 	fclose(df);
-	Printf(fs, "%%include <swig.swg>\n");
+	Printf(libfs, "%%include <swig.swg>\n");
 	if (allkw) {
-	  Printf(fs, "%%include <allkw.swg>\n");
+	  Printf(libfs, "%%include <allkw.swg>\n");
 	}
 	if (lang_config) {
-	  Printf(fs, "\n%%include <%s>\n", lang_config);
+	  Printf(libfs, "\n%%include <%s>\n", lang_config);
 	}
 	Printf(fs, "%%include(maininput=\"%s\") \"%s\"\n", Swig_filename_escape(input_file), Swig_filename_escape(Swig_last_file()));
 	for (i = 0; i < Len(libfiles); i++) {
 	  Printf(fs, "\n%%include \"%s\"\n", Swig_filename_escape(Getitem(libfiles, i)));
 	}
+	Seek(libfs, 0, SEEK_SET);
+	cpps = Preprocessor_parse_cached(libfs);
 	Seek(fs, 0, SEEK_SET);
-	cpps = Preprocessor_parse(fs);
+	rest = Preprocessor_parse(fs);
+	Append(cpps, rest);
+	Delete(rest);
+	Delete(libfs);
 	Delete(fs);
       } else {
 	cpps = Swig_read_file(df);
@@ -1103,9 +1143,9 @@ int SWIG_main(int argc, char *argv[], Language *l) {
 	  String *basename = Swig_file_basename(inputfile_filename);
 	  if (!outfile_name) {
 	    if (CPlusPlus || lang->cplus_runtime_mode()) {
-	      outfile = NewStringf("%s_wrap.%s", basename, cpp_extension);
+	      outfile = NewStringf("%s%s.%s", basename, wrap_suffix, cpp_extension);
 	    } else {
-	      outfile = NewStringf("%s_wrap.c", basename);
+	      outfile = NewStringf("%s%s.c", basename, wrap_suffix);
 	    }
 	  } else {
 	    outfile = NewString(outfile_name);
@@ -1117,7 +1157,7 @@ int SWIG_main(int argc, char *argv[], Language *l) {
 	      SWIG_exit(EXIT_FAILURE);
 	    }
 	  } else if (!depend_only) {
-	    String *filename = NewStringf("%s_wrap.%s", basename, depends_extension);
+	    String *filename = NewStringf("%s%s.%s", basename, wrap_suffix, depends_extension);
 	    f_dependencies_file = NewFile(filename, "w", SWIG_output_files());
 	    if (!f_dependencies_file) {
 	      FileErrorDisplay(filename);
@@ -1281,15 +1321,15 @@ int SWIG_main(int argc, char *argv[], Language *l) {
 	String *basename = Swig_file_basename(infile_filename);
 	if (!outfile_name) {
 	  if (CPlusPlus || lang->cplus_runtime_mode()) {
-	    Setattr(top, "outfile", NewStringf("%s_wrap.%s", basename, cpp_extension));
+	    Setattr(top, "outfile", NewStringf("%s%s.%s", basename, wrap_suffix, cpp_extension));
 	  } else {
-	    Setattr(top, "outfile", NewStringf("%s_wrap.c", basename));
+	    Setattr(top, "outfile", NewStringf("%s%s.c", basename, wrap_suffix));
 	  }
 	} else {
 	  Setattr(top, "outfile", outfile_name);
 	}
 	if (!outfile_name_h) {
-	  Setattr(top, "outfile_h", NewStringf("%s_wrap.%s", basename, hpp_extension));
+	  Setattr(top, "outfile_h", NewStringf("%s%s.%s", basename, wrap_suffix, hpp_extension));
 	} else {
 	  Setattr(top, "outfile_h", outfile_name_h);
 	}
@@ -1326,10 +1366,16 @@ int SWIG_main(int argc, char *argv[], Language *l) {
       lang = 0;
       Swig_print_xml(top, xmlout);
     }
-    Delete(top);
+    // Arena memory is released in bulk on exit, so don't bother tearing down the tree
+    if (!doh_arena)
+      Delete(top);
   }
   if (tm_debug)
     Swig_typemap_debug();
+  if (tm_search_debug)
+    Swig_typemap_search_debug_stats();
+  if (typesys_stats)
+    SwigType_print_cache_stats();
   if (memory_debug)
     DohMemoryDebug();
 
@@ -1349,8 +1395,10 @@ int SWIG_main(int argc, char *argv[], Language *l) {
   }
 
   // Deletes
-  Delete(libfiles);
-  Preprocessor_delete();
+  if (!doh_arena) {
+    Delete(libfiles);
+    Preprocessor_delete();
+  }
 
   while (freeze) {
   }
@@ -31,6 +31,11 @@ struct Overloaded {
 
 static int fast_dispatch_mode = 0;
 static int cast_dispatch_mode = 0;
+static int cache_dispatch_mode = 0;
+static int memo_dispatch_mode = 0;
+
+/* Number of entries in the cache of each dispatch function */
+#define DISPATCH_CACHE_SIZE 8
 
 /* Set fast_dispatch_mode */
 void Wrapper_fast_dispatch_mode_set(int flag) {
@@ -41,6 +46,18 @@ void Wrapper_cast_dispatch_mode_set(int flag) {
   cast_dispatch_mode = flag;
 }
 
+/* Set cache_dispatch_mode, the target language runtime must provide the
+   SWIG_Dispatch* functions used in the generated code */
+void Wrapper_cache_dispatch_mode_set(int flag) {
+  cache_dispatch_mode = flag;
+}
+
+/* Set memo_dispatch_mode, the pointers converted by the typechecks are
+   remembered by the SWIG_DispatchMemo* functions for the wrapper called */
+void Wrapper_memo_dispatch_mode_set(int flag) {
+  memo_dispatch_mode = flag;
+}
+
 /* -----------------------------------------------------------------------------
  * mark_implicitconv_function()
  *
@@ -364,6 +381,119 @@ List *Swig_overload_rank(Node *n, bool script_lang_wrapping) {
 //  * print_typecheck()
 //  * ----------------------------------------------------------------------------- */
 
+/* -----------------------------------------------------------------------------
+ * pointer_typecheck()
+ *
+ * Whether the typecheck of pj is the plain SWIGTYPE pointer check.  It can only
+ * pass for wrapped pointers and None/NULL and its result only depends on the
+ * type of the wrapped pointer, which is what cache_dispatch_mode relies on.
+ * ----------------------------------------------------------------------------- */
+
+static bool pointer_typecheck(Parm *pj, bool implicitconvtypecheckoff) {
+  String *tm = Getattr(pj, "tmap:typecheck");
+  String *match_type = Getattr(pj, "tmap:typecheck:match_type");
+  if (!tm || !match_type || !checkAttribute(pj, "tmap:typecheck:precedence", "0"))
+    return false;
+  String *conv = Getattr(pj, "implicitconv");
+  if (conv && !implicitconvtypecheckoff && !Equal(conv, "0"))
+    return false;
+  SwigType *base = SwigType_base(match_type);
+  bool plain = Equal(base, "SWIGTYPE") && Strstr(tm, "SWIG_ConvertPtr(");
+  Delete(base);
+  return plain;
+}
+
+/* -----------------------------------------------------------------------------
+ * pointer_overload()
+ *
+ * Whether all the arguments of the overload ni have a pointer typecheck
+ * ----------------------------------------------------------------------------- */
+
+static bool pointer_overload(Node *ni) {
+  bool implicitconvtypecheckoff = GetFlag(ni, "implicitconvtypecheckoff") != 0;
+  Parm *pj = Getattr(ni, "wrap:parms");
+  while (pj) {
+    if (checkAttribute(pj, "tmap:in:numinputs", "0")) {
+      pj = Getattr(pj, "tmap:in:next");
+      continue;
+    }
+    if (!pointer_typecheck(pj, implicitconvtypecheckoff))
+      return false;
+    Parm *pk = Getattr(pj, "tmap:in:next");
+    pj = pk ? pk : nextSibling(pj);
+  }
+  return true;
+}
+
+/* -----------------------------------------------------------------------------
+ * cacheable_dispatch()
+ *
+ * Whether the overload chosen by the dispatch function only depends on the
+ * argument count and the types of the wrapped pointers passed
+ * ----------------------------------------------------------------------------- */
+
+static bool cacheable_dispatch(List *dispatch) {
+  for (int i = 0; i < Len(dispatch); i++) {
+    if (!pointer_overload(Getitem(dispatch, i)))
+      return false;
+  }
+  return true;
+}
+
+/* -----------------------------------------------------------------------------
+ * memo_dispatch()
+ *
+ * With memo_dispatch_mode, flag the overloads that can use the pointers
+ * converted by their typechecks.  Only these overloads are called with the
+ * conversions remembered, as nothing but the pointer conversions runs between
+ * the typechecks and the conversion of the arguments in their wrapper.
+ * ----------------------------------------------------------------------------- */
+
+static bool memo_dispatch(List *dispatch) {
+  bool memo = false;
+  if (!memo_dispatch_mode)
+    return false;
+  for (int i = 0; i < Len(dispatch); i++) {
+    Node *ni = Getitem(dispatch, i);
+    if (pointer_overload(ni)) {
+      SetFlag(ni, "dispatch:memo");
+      memo = true;
+    }
+  }
+  return memo;
+}
+
+/* -----------------------------------------------------------------------------
+ * print_typecheck_guard()
+ *
+ * With cache_dispatch_mode, skip pointer typechecks for the values of builtin
+ * types that never hold a wrapped pointer.  Returns the number of braces opened.
+ * ----------------------------------------------------------------------------- */
+
+static int print_typecheck_guard(String *f, const char *input, Parm *pj, bool implicitconvtypecheckoff) {
+  if (!cache_dispatch_mode || !pointer_typecheck(pj, implicitconvtypecheckoff))
+    return 0;
+  Printf(f, "_v = 0;\n");
+  Printf(f, "if (!SWIG_DispatchIsValue(%s)) {\n", input);
+  return 1;
+}
+
+/* -----------------------------------------------------------------------------
+ * print_dispatch_call()
+ *
+ * Print the call of overload number index (starting at 1), recording it in the
+ * dispatch cache first when the dispatch function has one.  With memo, the
+ * conversions remembered are handed over to the overload or dropped.
+ * ----------------------------------------------------------------------------- */
+
+static void print_dispatch_call(String *f, String *lfmt, Node *ni, int index, bool memo) {
+  if (index)
+    Printf(f, "if (_entry) SWIG_DispatchCacheStore(_entry, %s, _keys, %d);\n", argc_template_string, index);
+  if (memo)
+    Printf(f, GetFlag(ni, "dispatch:memo") ? "SWIG_DispatchMemoUse();\n" : "SWIG_DispatchMemoEnd();\n");
+  Printf(f, Char(lfmt), Getattr(ni, "wrap:name"));
+}
+
 static bool print_typecheck(String *f, int j, Parm *pj, bool implicitconvtypecheckoff) {
   char tmp[256];
   sprintf(tmp, Char(argv_template_string), j);
@@ -371,6 +501,7 @@ static bool print_typecheck(String *f, int j, Parm *pj, bool implicitconvtypeche
   if (tm) {
     tm = Copy(tm);
     Replaceid(tm, Getattr(pj, "lname"), "_v");
+    int guard = print_typecheck_guard(f, tmp, pj, implicitconvtypecheckoff);
     String *conv = Getattr(pj, "implicitconv");
     if (conv && !implicitconvtypecheckoff) {
       Replaceall(tm, "$implicitconv", conv);
@@ -379,6 +510,8 @@ static bool print_typecheck(String *f, int j, Parm *pj, bool implicitconvtypeche
     }
     Replaceall(tm, "$input", tmp);
     Printv(f, tm, "\n", NIL);
+    if (guard)
+      Printf(f, "}\n");
     Delete(tm);
     return true;
   } else
@@ -404,6 +537,39 @@ static String *ReplaceFormat(const_String_or_char_ptr fmt, int j) {
   return lfmt;
 }
 
+/* -----------------------------------------------------------------------------
+ * print_dispatch_cache()
+ *
+ * Wrap the dispatch code in a block that first looks up the overload chosen by
+ * an earlier call with the same argument count and wrapped pointer types.
+ * ----------------------------------------------------------------------------- */
+
+static void print_dispatch_cache(String *f, List *dispatch, const_String_or_char_ptr fmt, int maxargs, bool wrap_this) {
+  char argv0[256];
+  sprintf(argv0, Char(argv_template_string), 0);
+  int stride = maxargs + 2;
+  String *lookup = NewString("{\n");
+  Printf(lookup, "void *_keys[%d];\n", maxargs);
+  Printf(lookup, "void **_entry = 0;\n");
+  Printf(lookup, "if (%s <= %d && SWIG_DispatchKeys(%s, &%s, _keys)) {\n", argc_template_string, maxargs, argc_template_string, argv0);
+  Printf(lookup, "static void *_cache[%d];\n", DISPATCH_CACHE_SIZE * stride);
+  Printf(lookup, "_entry = SWIG_DispatchCacheFind(_cache, %d, %d, %s, _keys);\n", DISPATCH_CACHE_SIZE, stride, argc_template_string);
+  Printf(lookup, "switch (SWIG_DispatchCacheIndex(_entry, %s, _keys)) {\n", argc_template_string);
+  for (int i = 0; i < Len(dispatch); i++) {
+    Node *ni = Getitem(dispatch, i);
+    int num_arguments = emit_num_arguments(Getattr(ni, "wrap:parms"));
+    String *lfmt = ReplaceFormat(fmt, wrap_this ? num_arguments + 1 : num_arguments);
+    Printf(lookup, "case %d:\n", i + 1);
+    Printf(lookup, Char(lfmt), Getattr(ni, "wrap:name"));
+    Printf(lookup, "\n");
+    Delete(lfmt);
+  }
+  Printf(lookup, "default:\nbreak;\n}\n}\n");
+  Insert(f, 0, lookup);
+  Printf(f, "}\n");
+  Delete(lookup);
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_overload_dispatch()
  *
@@ -620,6 +786,10 @@ String *Swig_overload_dispatch_fast(Node *n, const_String_or_char_ptr fmt, int *
   /* Get a list of methods ranked by precedence values and argument count */
   List *dispatch = Swig_overload_rank(n, true);
   int nfunc = Len(dispatch);
+  bool cached = cache_dispatch_mode && cacheable_dispatch(dispatch);
+  bool memo = memo_dispatch(dispatch);
+  if (memo)
+    Printf(f, "SWIG_DispatchMemoBegin();\n");
 
   /* Loop over the functions */
 
@@ -727,7 +897,10 @@ String *Swig_overload_dispatch_fast(Node *n, const_String_or_char_ptr fmt, int *
 	      Replaceall(tm, "$implicitconv", "0");
 	    }
 	    Replaceall(tm, "$input", tmp);
+	    int guard = print_typecheck_guard(f, Char(tmp), pj, implicitconvtypecheckoff);
 	    Printv(f, "{\n", tm, "}\n", NIL);
+	    if (guard)
+	      Printf(f, "}\n");
 	    Delete(tm);
 	    fn = i + 1;
 	    Printf(f, "if (!_v) goto check_%d;\n", fn);
@@ -754,7 +927,7 @@ String *Swig_overload_dispatch_fast(Node *n, const_String_or_char_ptr fmt, int *
 
 
     String *lfmt = ReplaceFormat(fmt, num_arguments);
-    Printf(f, Char(lfmt), Getattr(ni, "wrap:name"));
+    print_dispatch_call(f, lfmt, ni, cached ? i + 1 : 0, memo);
 
     Printf(f, "}\n");		/* braces closes "if" for this method */
     if (fn)
@@ -766,6 +939,10 @@ String *Swig_overload_dispatch_fast(Node *n, const_String_or_char_ptr fmt, int *
     Delete(lfmt);
     Delete(coll);
   }
+  if (memo)
+    Printf(f, "SWIG_DispatchMemoEnd();\n");
+  if (cached)
+    print_dispatch_cache(f, dispatch, fmt, *maxargs, false);
   Delete(dispatch);
   return f;
 }
@@ -785,6 +962,10 @@ String *Swig_overload_dispatch(Node *n, const_String_or_char_ptr fmt, int *maxar
   /* Get a list of methods ranked by precedence values and argument count */
   List *dispatch = Swig_overload_rank(n, true);
   int nfunc = Len(dispatch);
+  bool cached = cache_dispatch_mode && cacheable_dispatch(dispatch);
+  bool memo = memo_dispatch(dispatch);
+  if (memo)
+    Printf(f, "SWIG_DispatchMemoBegin();\n");
 
   /* Loop over the functions */
 
@@ -822,7 +1003,7 @@ String *Swig_overload_dispatch(Node *n, const_String_or_char_ptr fmt, int *maxar
       if (j >= num_required) {
 	String *lfmt = ReplaceFormat(fmt, num_arguments);
 	Printf(f, "if (%s <= %d) {\n", argc_template_string, j);
-	Printf(f, Char(lfmt), Getattr(ni, "wrap:name"));
+	print_dispatch_call(f, lfmt, ni, cached ? i + 1 : 0, memo);
 	Printf(f, "}\n");
 	Delete(lfmt);
       }
@@ -844,7 +1025,7 @@ String *Swig_overload_dispatch(Node *n, const_String_or_char_ptr fmt, int *maxar
       j++;
     }
     String *lfmt = ReplaceFormat(fmt, num_arguments);
-    Printf(f, Char(lfmt), Getattr(ni, "wrap:name"));
+    print_dispatch_call(f, lfmt, ni, cached ? i + 1 : 0, memo);
     Delete(lfmt);
     /* close braces */
     for ( /* empty */ ; num_braces > 0; num_braces--)
@@ -853,6 +1034,10 @@ String *Swig_overload_dispatch(Node *n, const_String_or_char_ptr fmt, int *maxar
     if (implicitconvtypecheckoff)
       Delattr(ni, "implicitconvtypecheckoff");
   }
+  if (memo)
+    Printf(f, "SWIG_DispatchMemoEnd();\n");
+  if (cached)
+    print_dispatch_cache(f, dispatch, fmt, *maxargs, GetFlag(n, "wrap:this") != 0);
   Delete(dispatch);
   return f;
 }
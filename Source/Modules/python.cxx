@@ -83,6 +83,8 @@ static String *real_classname;
 /* Thread Support */
 static int threads = 0;
 static int nothreads = 0;
+static int autothreads = 0;
+static int threadreport = 0;
 static int classptr = 0;
 /* Other options */
 static int shadowimport = 1;
@@ -92,6 +94,7 @@ static int safecstrings = 0;
 static int dirvtable = 0;
 static int proxydel = 1;
 static int fastunpack = 0;
+static int fastcall = 0;
 static int fastproxy = 0;
 static int fastquery = 0;
 static int fastinit = 0;
@@ -103,6 +106,8 @@ static int extranative = 0;
 static int outputtuple = 0;
 static int nortti = 0;
 static int relativeimport = 0;
+static int slotthis = 0;
+static int convertonce = 0;
 
 /* flags for the make_autodoc function */
 enum autodoc_t {
@@ -118,14 +123,18 @@ enum autodoc_t {
 static const char *usage1 = "\
 Python Options (available with -python)\n\
      -aliasobj0      - Alias obj0 when using fastunpack, needed for some old typemaps \n\
+     -autothreads    - Add thread support, but keep the GIL around variable accessors and trivial inline functions\n\
      -buildnone      - Use Py_BuildValue(" ") to obtain Py_None (default in Windows)\n\
      -builtin        - Create new python built-in types, rather than proxy classes, for better performance\n\
+     -cachedispatch  - Cache the overload chosen for the wrapped pointer types passed to overloaded functions\n\
      -castmode       - Enable the casting mode, which allows implicit cast between types in python\n\
      -classic        - Use classic classes only\n\
      -classptr       - Generate shadow 'ClassPtr' as in older swig versions\n\
+     -convertonce    - Reuse the pointer conversions done when dispatching overloaded functions\n\
      -cppcast        - Enable C++ casting operators (default) \n\
      -dirvtable      - Generate a pseudo virtual table for directors for faster dispatch \n\
      -extranative    - Return extra native C++ wraps for std containers when possible \n\
+     -fastcall       - Use the METH_FASTCALL calling convention for the wrapper functions (Python 3.7 or later)\n\
      -fastinit       - Use fast init mechanism for classes (default)\n\
      -fastunpack     - Use fast unpack mechanism to parse the argument functions \n\
      -fastproxy      - Use fast proxy mechanism for member methods \n\
@@ -167,6 +176,8 @@ static const char *usage3 = "\
      -proxydel       - Generate a __del__ method even though it is now redundant (default) \n\
      -relativeimport - Use relative python imports \n\
      -safecstrings   - Use safer (but slower) C string mapping, generating copies from Python -> C/C++\n\
+     -slotthis       - Keep the 'this' object of proxy classes in a slot rather than the instance dictionary, implies -fastinit\n\
+     -threadreport   - Report which wrapper functions release the GIL\n\
      -threads        - Add thread support for all the interface\n\
      -O              - Enable the following optimization options: \n\
                          -modern -fastdispatch -nosafecstrings -fvirtual -noproxydel \n\
@@ -268,6 +279,51 @@ public:
     return threads && !GetFlagAttr(n, "feature:nothread");
   }
 
+  /* ------------------------------------------------------------
+   * trivial_inline()
+   *
+   * Whether n is a function defined inline with a body of at most
+   * one statement and no calls, e.g. { return x; }
+   * ------------------------------------------------------------ */
+
+  static bool trivial_inline(Node *n) {
+    String *code = Getattr(n, "code");
+    if (!code || !Equal(nodeType(n), "cdecl"))
+      return false;
+    int statements = 0;
+    for (const char *c = Char(code); *c; ++c) {
+      if (*c == '(')
+	return false;
+      if (*c == ';')
+	++statements;
+    }
+    return statements <= 1;
+  }
+
+  /* ------------------------------------------------------------
+   * threads_hold()
+   *
+   * Returns why the GIL is held around the wrapped call, or 0 if it is
+   * released.  An explicit %threadallow/%nothreadallow always takes
+   * precedence over the -autothreads policy.
+   * ------------------------------------------------------------ */
+
+  const char *threads_hold(Node *n) const {
+    if (!threads_enable(n))
+      return "no thread support";
+    if (Getattr(n, "feature:nothreadallow"))
+      return GetFlag(n, "feature:nothreadallow") ? "%nothreadallow" : 0;
+    if (autothreads) {
+      if (GetFlag(n, "memberget") || GetFlag(n, "memberset") || GetFlag(n, "varget") || GetFlag(n, "varset"))
+	return "variable accessor";
+      if (GetFlag(n, "feature:trivialcall"))
+	return "%feature(\"trivialcall\")";
+      if (trivial_inline(n))
+	return "trivial inline function";
+    }
+    return 0;
+  }
+
   int initialize_threads(String *f_init) {
     if (!threads) {
       return SWIG_OK;
@@ -302,7 +358,7 @@ public:
   }
 
   virtual void thread_begin_allow(Node *n, String *f) {
-    if (!GetFlag(n, "feature:nothreadallow")) {
+    if (!threads_hold(n)) {
       String *bb = Getattr(n, "feature:threadbeginallow");
       Append(f, "{\n");
       if (bb) {
@@ -314,7 +370,7 @@ public:
   }
 
   virtual void thread_end_allow(Node *n, String *f) {
-    if (!GetFlag(n, "feature:nothreadallow")) {
+    if (!threads_hold(n)) {
       String *eb = Getattr(n, "feature:threadendallow");
       Append(f, "\n");
       if (eb) {
@@ -402,6 +458,13 @@ public:
 	} else if (strcmp(argv[i], "-threads") == 0) {
 	  threads = 1;
 	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-autothreads") == 0) {
+	  threads = 1;
+	  autothreads = 1;
+	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-threadreport") == 0) {
+	  threadreport = 1;
+	  Swig_mark_arg(i);
 	} else if (strcmp(argv[i], "-nothreads") == 0) {
 	  /* Turn off thread suppor mode */
 	  nothreads = 1;
@@ -426,6 +489,16 @@ public:
 	} else if (strcmp(argv[i], "-nodirvtable") == 0) {
 	  dirvtable = 0;
 	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-cachedispatch") == 0) {
+	  Wrapper_cache_dispatch_mode_set(1);
+	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-convertonce") == 0) {
+	  convertonce = 1;
+	  Wrapper_memo_dispatch_mode_set(1);
+	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-fastcall") == 0) {
+	  fastcall = 1;
+	  Swig_mark_arg(i);
 	} else if (strcmp(argv[i], "-fastunpack") == 0) {
 	  fastunpack = 1;
 	  Swig_mark_arg(i);
@@ -534,6 +607,9 @@ public:
 	} else if (strcmp(argv[i], "-relativeimport") == 0) {
 	  relativeimport = 1;
 	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-slotthis") == 0) {
+	  slotthis = 1;
+	  Swig_mark_arg(i);
 	}
 
       }
@@ -544,6 +620,21 @@ public:
       classic = 0;
     }
 
+    if (classic || builtin) {
+      /* classic classes cannot have slots and builtin types have no proxy classes */
+      slotthis = 0;
+    }
+
+    if (slotthis) {
+      /* the traditional init looks up the empty slot, which is slow */
+      fastinit = 1;
+    }
+
+    if (builtin) {
+      /* the wrappers of builtin types are also called through the tp slot closures */
+      fastcall = 0;
+    }
+
     if (cppcast) {
       Preprocessor_define((DOH *) "SWIG_CPLUSPLUS_CAST", 0);
     }
@@ -592,6 +683,10 @@ public:
 	  if (Getattr(options, "threads")) {
 	    threads = 1;
 	  }
+	  if (Getattr(options, "autothreads")) {
+	    threads = 1;
+	    autothreads = 1;
+	  }
 	  if (Getattr(options, "castmode")) {
 	    castmode = 1;
 	  }
@@ -630,9 +725,9 @@ public:
       SWIG_exit(EXIT_FAILURE);
     }
     f_runtime = NewString("");
-    f_init = NewString("");
+    f_init = Swig_new_section();
     f_header = NewString("");
-    f_wrappers = NewString("");
+    f_wrappers = Swig_new_section();
     f_directors_h = NewString("");
     f_directors = NewString("");
     builtin_getset = NewHash();
@@ -727,6 +822,18 @@ public:
       Printf(f_runtime, "#define SWIGPYTHON_BUILTIN\n");
     }
 
+    if (slotthis) {
+      Printf(f_runtime, "#define SWIG_PYTHON_SLOT_THIS\n");
+    }
+
+    if (fastcall) {
+      Printf(f_runtime, "#define SWIG_PYTHON_FASTCALL\n");
+    }
+
+    if (convertonce) {
+      Printf(f_runtime, "#define SWIG_PYTHON_CONVERT_ONCE\n");
+    }
+
     Printf(f_runtime, "\n");
 
     Printf(f_header, "#if (PY_VERSION_HEX <= 0x02000000)\n");
@@ -753,6 +860,12 @@ public:
       Printf(f_header, "#endif\n");
     }
 
+    if (fastcall) {
+      Printf(f_header, "#if (PY_VERSION_HEX < 0x03070000)\n");
+      Printf(f_header, "# error \"This python version requires swig to be run without the '-fastcall' option\"\n");
+      Printf(f_header, "#endif\n");
+    }
+
     if (fastquery) {
       Printf(f_header, "#ifdef SWIG_TypeQuery\n");
       Printf(f_header, "# undef SWIG_TypeQuery\n");
@@ -928,7 +1041,8 @@ public:
 	Printv(f_shadow,
 	       "\n", "def _swig_setattr_nondynamic(self, class_type, name, value, static=1):\n",
 	       tab4, "if (name == \"thisown\"):\n", tab8, "return self.this.own(value)\n",
-	       tab4, "if (name == \"this\"):\n", tab8, "if type(value).__name__ == 'SwigPyObject':\n", tab4, tab8, "self.__dict__[name] = value\n",
+	       tab4, "if (name == \"this\"):\n", tab8, "if type(value).__name__ == 'SwigPyObject':\n", tab4, tab8,
+	       slotthis ? "object.__setattr__(self, name, value)\n" : "self.__dict__[name] = value\n",
 #ifdef USE_THISOWN
 	       tab4, tab8, "if hasattr(value,\"thisown\"):\n", tab8, tab8, "self.__dict__[\"thisown\"] = value.thisown\n", tab4, tab8, "del value.thisown\n",
 #endif
@@ -972,6 +1086,9 @@ public:
 		 "except __builtin__.Exception:\n",
 		 tab4, "class _object:\n", tab8, "pass\n", tab4, "_newclass = 0\n\n", NIL);
 	}
+	if (slotthis) {
+	  Printv(f_shadow, "_object = ", module, ".SwigPyProxy\n\n", NIL);
+	}
       }
       if (modern) {
 	Printv(f_shadow,  "\n", "def _swig_setattr_nondynamic_method(set):\n", tab4, "def set_attr(self, name, value):\n",
@@ -2474,8 +2591,10 @@ public:
    * add_method()
    * ------------------------------------------------------------ */
 
-  void add_method(String *name, String *function, int kw, Node *n = 0, int funpack= 0, int num_required= -1, int num_arguments = -1) {
-    if (!kw) {
+  void add_method(String *name, String *function, int kw, Node *n = 0, int funpack= 0, int num_required= -1, int num_arguments = -1, int fastcall_wrapper = 0) {
+    if (fastcall_wrapper) {
+      Printf(methods, "\t { (char *)\"%s\", (PyCFunction)(void(*)(void))%s, METH_FASTCALL%s, ", name, function, kw ? " | METH_KEYWORDS" : "");
+    } else if (!kw) {
       if (n && funpack) {
 	if (num_required == 0 && num_arguments == 0) {
 	  Printf(methods, "\t { (char *)\"%s\", (PyCFunction)%s, METH_NOARGS, ", name, function);
@@ -2534,13 +2653,25 @@ public:
     String *wname = Swig_name_wrapper(symname);
 
     const char *builtin_kwargs = builtin_ctor ? ", PyObject *SWIGUNUSEDPARM(kwargs)" : "";
-    Printv(f->def, linkage, builtin_ctor ? "int " : "PyObject *", wname, "(PyObject *self, PyObject *args", builtin_kwargs, ") {", NIL);
+    bool fastcall_dispatch = fastcall && funpack;
+    if (fastcall_dispatch) {
+      Printv(f->def, linkage, "PyObject *", wname, "(PyObject *self, PyObject *const *args, Py_ssize_t nargs) {", NIL);
+    } else {
+      Printv(f->def, linkage, builtin_ctor ? "int " : "PyObject *", wname, "(PyObject *self, PyObject *args", builtin_kwargs, ") {", NIL);
+    }
 
     Wrapper_add_local(f, "argc", "Py_ssize_t argc");
     Printf(tmp, "PyObject *argv[%d] = {0}", maxargs + 1);
     Wrapper_add_local(f, "argv", tmp);
 
-    if (!fastunpack) {
+    if (fastcall_dispatch) {
+      Wrapper_add_local(f, "ii", "Py_ssize_t ii");
+      Printf(f->code, "if (nargs > %d) SWIG_fail;\n", maxargs);
+      Append(f->code, "for (ii = 0; ii < nargs; ii++) {\n");
+      Append(f->code, "argv[ii] = args[ii];\n");
+      Append(f->code, "}\n");
+      Append(f->code, "argc = nargs;\n");
+    } else if (!fastunpack) {
       Wrapper_add_local(f, "ii", "Py_ssize_t ii");
 
       if (maxargs - (add_self ? 1 : 0) > 0) {
@@ -2594,7 +2725,7 @@ public:
     Wrapper_print(f, f_wrappers);
     Node *p = Getattr(n, "sym:previousSibling");
     if (!builtin_self)
-      add_method(symname, wname, 0, p);
+      add_method(symname, wname, 0, p, 0, -1, -1, fastcall_dispatch);
 
     /* Create a shadow for this function (if enabled and not in a member function) */
     if (!builtin && (shadow) && (!(shadow & PYSHADOW_MEMBER))) {
@@ -2792,7 +2923,8 @@ public:
 	over_varargs = true;
     }
 
-    int funpack = modernargs && fastunpack && !varargs && !over_varargs && !allow_kwargs;
+    int funpack = (fastcall || (modernargs && fastunpack)) && !varargs && !over_varargs && (fastcall || !allow_kwargs);
+    int fastcall_wrapper = 0;
     int noargs = funpack && (tuple_required == 0 && tuple_arguments == 0);
     int onearg = funpack && (tuple_required == 1 && tuple_arguments == 1);
 
@@ -2937,7 +3069,7 @@ public:
 
     if (builtin && !funpack && in_class && tuple_arguments == 0) {
       Printf(parse_args, "    if (args && PyTuple_Check(args) && PyTuple_GET_SIZE(args) > 0) SWIG_exception_fail(SWIG_TypeError, \"%s takes no arguments\");\n", iname);
-    } else if (use_parse || allow_kwargs || !modernargs) {
+    } else if (use_parse || (!fastcall && (allow_kwargs || !modernargs))) {
       Printf(parse_args, ":%s\"", iname);
       Printv(parse_args, arglist, ")) SWIG_fail;\n", NIL);
       funpack = 0;
@@ -2952,6 +3084,16 @@ public:
 	    Printv(f->def, linkage, wrap_return, wname, "(PyObject *", self_param, ", Py_ssize_t nobjs, PyObject **swig_obj) {", NIL);
 	  }
 	  Printf(parse_args, "if ((nobjs < %d) || (nobjs > %d)) SWIG_fail;\n", num_required, num_arguments);
+	} else if (fastcall && allow_kwargs) {
+	  Printv(f->def, linkage, wrap_return, wname, "(PyObject *", self_param, ", PyObject *const *args, Py_ssize_t nargs, PyObject *kwargs) {", NIL);
+	  Printf(f->locals, "  static PyObject *kwobjs[%d] = {0};\n", tuple_arguments + 1);
+	  Printf(parse_args, "if (!SWIG_Python_UnpackFastcallKeywords(args,nargs,kwargs,\"%s\",kwnames,kwobjs,%d,%d,%s)) SWIG_fail;\n", iname, num_fixed_arguments, tuple_arguments,
+		 num_arguments ? "swig_obj" : "0");
+	  fastcall_wrapper = 1;
+	} else if (fastcall && !noargs && !onearg) {
+	  Printv(f->def, linkage, wrap_return, wname, "(PyObject *", self_param, ", PyObject *const *args, Py_ssize_t nargs) {", NIL);
+	  Printf(parse_args, "if (!SWIG_Python_UnpackFastcall(args,nargs,\"%s\",%d,%d,swig_obj)) SWIG_fail;\n", iname, num_fixed_arguments, tuple_arguments);
+	  fastcall_wrapper = 1;
 	} else {
 	  Printv(f->def, linkage, wrap_return, wname, "(PyObject *", self_param, ", PyObject *args", builtin_kwargs, ") {", NIL);
 	  if (onearg && !builtin_ctor) {
@@ -2972,6 +3114,11 @@ public:
     /* Now piece together the first part of the wrapper function */
     Printv(f->code, self_parse, parse_args, get_pointers, NIL);
 
+    /* The conversions remembered by the dispatch function are used up */
+    if (convertonce && overname) {
+      Append(f->code, "SWIG_DispatchMemoEnd();\n");
+    }
+
     /* Check for trailing varargs */
     if (varargs) {
       if (p && (tm = Getattr(p, "tmap:in"))) {
@@ -3083,6 +3230,14 @@ public:
       }
     }
 
+    if (threadreport) {
+      const char *hold = director_method ? "director method" : threads_hold(n);
+      if (hold)
+	Printf(stdout, "%s:%d: %s holds the GIL (%s)\n", Getfile(n), Getline(n), wname, hold);
+      else
+	Printf(stdout, "%s:%d: %s releases the GIL\n", Getfile(n), Getline(n), wname);
+    }
+
     Setattr(n, "wrap:name", wname);
 
     Swig_director_emit_dynamic_cast(n, f);
@@ -3204,6 +3359,9 @@ public:
     /* Error handling code */
 
     Append(f->code, "fail:\n");
+    if (convertonce && overname) {
+      Append(f->code, "SWIG_DispatchMemoEnd();\n");
+    }
     if (need_cleanup) {
       Printv(f->code, cleanup, NIL);
     }
@@ -3289,7 +3447,7 @@ public:
     /* Now register the function with the interpreter.   */
     if (!Getattr(n, "sym:overloaded")) {
       if (!builtin_self)
-	add_method(iname, wname, allow_kwargs, n, funpack, num_required, num_arguments);
+	add_method(iname, wname, allow_kwargs, n, funpack, num_required, num_arguments, fastcall_wrapper);
 
       /* Create a shadow for this function (if enabled and not in a member function) */
       if (!builtin && (shadow) && (!(shadow & PYSHADOW_MEMBER))) {
@@ -4465,7 +4623,7 @@ public:
 	  Printf(f_shadow, "(%s)", base_class);
 	} else {
 	  if (!classic) {
-	    Printf(f_shadow, modern ? "(object)" : "(_object)");
+	    Printf(f_shadow, (modern && !slotthis) ? "(object)" : "(_object)");
 	  }
 	  if (GetFlag(n, "feature:exceptionclass")) {
 	    Printf(f_shadow, "(Exception)");
@@ -131,6 +131,7 @@ enum autodoc_t {
 static const char *usage = "\
 Ruby Options (available with -ruby)\n\
      -autorename     - Enable renaming of classes and methods to follow Ruby coding standards\n\
+     -convertonce    - Reuse the pointer conversions done when dispatching overloaded methods\n\
      -cppcast        - Enable C++ casting operators (default)\n\
      -globalmodule   - Wrap everything into the global module\n\
      -initname <name>- Set entry function to Init_<name> (used by `require')\n\
@@ -170,6 +171,7 @@ private:
 
   bool useGlobalModule;
   bool multipleInheritance;
+  bool convertonce;
 
   // Wrap modes
   enum WrapperMode {
@@ -824,6 +826,7 @@ public:
     f_initbeforefunc(0),
     useGlobalModule(false),
     multipleInheritance(false),
+    convertonce(false),
     last_mode(AUTODOC_NONE),
     last_autodoc(NewString("")) {
       current = NO_CPP;
@@ -883,6 +886,10 @@ public:
 	  multipleInheritance = true;
 	  director_multiple_inheritance = 1;
 	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-convertonce") == 0) {
+	  convertonce = true;
+	  Wrapper_memo_dispatch_mode_set(1);
+	  Swig_mark_arg(i);
 	} else if (strcmp(argv[i], "-cppcast") == 0) {
 	  cppcast = 1;
 	  Swig_mark_arg(i);
@@ -1106,6 +1113,10 @@ public:
       Printf(f_runtime, "#define SWIG_DIRECTORS\n");
     }
 
+    if (convertonce) {
+      Printf(f_runtime, "#define SWIG_RUBY_CONVERT_ONCE\n");
+    }
+
     Printf(f_runtime, "\n");
 
     /* typedef void *VALUE */
@@ -1788,6 +1799,10 @@ public:
     /* to get arguments */
     if (current != CONSTRUCTOR_ALLOCATE) {
       marshalInputArgs(n, l, numarg, numreq, kwargs, allow_kwargs, f);
+      /* The conversions remembered by the dispatch function are used up */
+      if (convertonce && overname) {
+	Append(f->code, "SWIG_DispatchMemoEnd();\n");
+      }
     }
     // FIXME?
     if (ctor_director) {
@@ -2015,6 +2030,9 @@ public:
       } else if (current == CONSTRUCTOR_INITIALIZE) {
 	Printv(f->code, tab4, "return self;\n", NIL);
 	Printv(f->code, "fail:\n", NIL);
+	if (convertonce && overname) {
+	  Append(f->code, "SWIG_DispatchMemoEnd();\n");
+	}
 	if (need_cleanup) {
 	  Printv(f->code, cleanup, NIL);
 	}
@@ -2023,6 +2041,9 @@ public:
 	Wrapper_add_local(f, "vresult", "VALUE vresult = Qnil");
 	Printv(f->code, tab4, "return vresult;\n", NIL);
 	Printv(f->code, "fail:\n", NIL);
+	if (convertonce && overname) {
+	  Append(f->code, "SWIG_DispatchMemoEnd();\n");
+	}
 	if (need_cleanup) {
 	  Printv(f->code, cleanup, NIL);
 	}
@@ -2031,6 +2052,9 @@ public:
     } else {
       Printv(f->code, tab4, "return Qnil;\n", NIL);
       Printv(f->code, "fail:\n", NIL);
+      if (convertonce && overname) {
+	Append(f->code, "SWIG_DispatchMemoEnd();\n");
+      }
       if (need_cleanup) {
 	Printv(f->code, cleanup, NIL);
       }
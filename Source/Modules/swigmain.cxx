@@ -18,6 +18,12 @@
 
 #include "swigmod.h"
 #include <ctype.h>
+#include <errno.h>
+#if !defined(_WIN32)
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 /* Module factories.  These functions are used to instantiate
    the built-in language modules.    If adding a new language
@@ -152,10 +158,106 @@ void SWIG_merge_envopt(const char *env, int oargc, char *oargv[], int *nargc, ch
   *nargv = argv;
 }
 
+/* -----------------------------------------------------------------------------
+ * fork_languages()
+ *
+ * Called when more than one target language option is given.  The preprocessor
+ * and parser output depend on the target language, through the SWIG<LANG> macro
+ * and the language's library files, and SWIG's core keeps its state in globals.
+ * So each language is generated by its own child process and the children run
+ * concurrently.  Each child writes <input>_<lang>_wrap.<ext> rather than
+ * <input>_wrap.<ext>.  Returns the argv index of the language for a child to
+ * generate, the parent exits once all the children have finished.
+ * ----------------------------------------------------------------------------- */
+
+static int fork_languages(int argc, char **argv) {
+  int i;
+#if defined(_WIN32)
+  (void)argc;
+  (void)argv;
+  (void)i;
+  Printf(stderr, "Only one target language option can be given on this platform.\n");
+  SWIG_exit(EXIT_FAILURE);
+  return 0;
+#else
+  int nchildren = 0;
+  int failed = 0;
+  int status;
+
+  for (i = 1; i < argc; i++) {
+    if (argv[i] && ((strcmp(argv[i], "-o") == 0) || (strcmp(argv[i], "-oh") == 0))) {
+      Printf(stderr, "The %s option cannot be used with more than one target language option.\n", argv[i]);
+      SWIG_exit(EXIT_FAILURE);
+    }
+  }
+
+  fflush(stdout);
+  fflush(stderr);
+  for (i = 1; i < argc; i++) {
+    if (argv[i] && Swig_find_module(argv[i])) {
+      pid_t pid = fork();
+      if (pid == 0) {
+	String *suffix = NewStringf("_%s_wrap", argv[i] + 1);
+	SWIG_config_wrap_suffix(Char(suffix));
+	return i;
+      }
+      if (pid < 0) {
+	Printf(stderr, "Unable to start code generation for %s: %s\n", argv[i], strerror(errno));
+	failed = 1;
+	break;
+      }
+      nchildren++;
+    }
+  }
+  while (nchildren > 0 && wait(&status) > 0) {
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)
+      failed = 1;
+    nchildren--;
+  }
+  SWIG_exit(failed ? EXIT_FAILURE : EXIT_SUCCESS);
+  return 0;
+#endif
+}
+
+/* -----------------------------------------------------------------------------
+ * scope_language_options()
+ *
+ * An option prefixed by a target language option and a colon, such as
+ * -java:package, is only used by that language.  The prefix is removed for the
+ * language being generated, lang, and the option is ignored by the others.  An
+ * argument following an ignored option is ignored too unless it is an option or
+ * the input file, as it can only be the value of the ignored option.
+ * ----------------------------------------------------------------------------- */
+
+static void scope_language_options(int argc, char **argv, const char *lang) {
+  size_t lang_len = strlen(lang);
+  for (int i = 1; i < argc - 1; i++) {
+    char *colon = (argv[i] && argv[i][0] == '-') ? strchr(argv[i], ':') : 0;
+    if (colon) {
+      size_t prefix_len = (size_t)(colon - argv[i]);
+      String *prefix = NewStringWithSize(argv[i], (int)prefix_len);
+      if (Swig_find_module(Char(prefix))) {
+	if (prefix_len == lang_len && strncmp(argv[i], lang, lang_len) == 0) {
+	  memmove(argv[i] + 1, colon + 1, strlen(colon + 1) + 1);
+	} else {
+	  Swig_mark_arg(i);
+	  if (i + 1 < argc - 1 && argv[i + 1] && argv[i + 1][0] != '-')
+	    Swig_mark_arg(++i);
+	}
+      }
+      Delete(prefix);
+    }
+  }
+}
+
 int main(int margc, char **margv) {
   int i;
   Language *dl = 0;
   ModuleFactory fac = 0;
+  int nlangs = 0;
+  int help = 0;
+  int lang_index = 0;
+  const char *lang = SWIG_LANG;
 
   int argc;
   char **argv;
@@ -167,19 +269,43 @@ int main(int margc, char **margv) {
   argc = ccommand(&argv);
 #endif
 
+  /* Arena allocation has to be turned on before any DOH objects are created */
+  for (i = 1; i < argc; i++) {
+    if (argv[i] && strcmp(argv[i], "-doh-arena") == 0)
+      DohSetMemoryArena(1);
+  }
+
   /* Register built-in modules */
   for (i = 0; modules[i].name; i++) {
     Swig_register_module(modules[i].name, modules[i].fac);
   }
 
+  /* Several target languages are generated in parallel by separate processes */
+  for (i = 1; i < argc; i++) {
+    if (argv[i]) {
+      if (Swig_find_module(argv[i])) {
+	if (!nlangs)
+	  lang = argv[i];
+	nlangs++;
+      } else if ((strcmp(argv[i], "-help") == 0) || (strcmp(argv[i], "--help") == 0))
+	help = 1;
+    }
+  }
+  if (nlangs > 1 && !help) {
+    lang_index = fork_languages(argc, argv);
+    lang = argv[lang_index];
+  }
+
   Swig_init_args(argc, argv);
+  scope_language_options(argc, argv, lang);
 
   /* Get options */
   for (i = 1; i < argc; i++) {
     if (argv[i]) {
       fac = Swig_find_module(argv[i]);
       if (fac) {
-	dl = (fac) ();
+	if (!lang_index || i == lang_index)
+	  dl = (fac) ();
 	Swig_mark_arg(i);
       } else if (strcmp(argv[i], "-nolang") == 0) {
 	dl = new Language;
@@ -193,6 +319,10 @@ int main(int margc, char **margv) {
 	    Printf(stdout, "     %-15s - Generate %s wrappers\n", modules[j].name, modules[j].help);
 	  }
 	}
+	Printf(stdout, "\n     More than one target language option can be given, each language is generated\n"
+	       "     in parallel by a separate process and writes <file>_<lang>_wrap.<ext>.\n"
+	       "     An option prefixed by a language option, such as -java:package <name>, is only\n"
+	       "     used by that language\n");
 	// Swig_mark_arg not called as the general -help options also need to be displayed later on
       }
     }
@@ -360,6 +360,7 @@ void SWIG_exit(int);		/* use EXIT_{SUCCESS,FAILURE} */
 void SWIG_config_file(const_String_or_char_ptr );
 const String *SWIG_output_directory();
 void SWIG_config_cppext(const char *ext);
+void SWIG_config_wrap_suffix(const char *suffix);
 void Swig_print_xml(Node *obj, String *filename);
 
 /* get the list of generated files */
@@ -411,6 +412,8 @@ int is_non_virtual_protected_access(Node *n); /* Check if the non-virtual protec
 void Wrapper_virtual_elimination_mode_set(int);
 void Wrapper_fast_dispatch_mode_set(int);
 void Wrapper_cast_dispatch_mode_set(int);
+void Wrapper_cache_dispatch_mode_set(int);
+void Wrapper_memo_dispatch_mode_set(int);
 void Wrapper_naturalvar_mode_set(int);
 
 void clean_overloaded(Node *n);
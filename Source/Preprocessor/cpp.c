@@ -20,6 +20,12 @@
 #include "swig.h"
 #include "preprocessor.h"
 #include <ctype.h>
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
 
 static Hash *cpp = 0;		/* C preprocessor data */
 static int include_all = 0;	/* Follow all includes */
@@ -35,6 +41,9 @@ static int expand_defined_operator = 0;
 static int macro_level = 0;
 static int macro_start_line = 0;
 static const String * macro_start_file = 0;
+static String *cache_dir = 0;	/* Directory for Preprocessor_parse_cached() */
+static List *cache_pragmas = 0;	/* #pragma SWIG nowarn= values seen while filling the cache */
+static Hash *cache_macros = 0;	/* Macros used while filling the cache, see macro_lookup() */
 
 /* Test a character to see if it starts an identifier */
 #define isidentifier(c) ((isalpha(c)) || (c == '_') || (c == '$'))
@@ -75,6 +84,8 @@ static int skip_tochar(String *s, int ch, String *out) {
   return 0;
 }
 
+static Hash *macro_lookup(Hash *symbols, const_String_or_char_ptr name);
+
 static void copy_location(const DOH *s1, DOH *s2) {
   Setfile(s2, Getfile((DOH *) s1));
   Setline(s2, Getline((DOH *) s1));
@@ -518,7 +529,7 @@ Hash *Preprocessor_define(const_String_or_char_ptr _str, int swigmacro) {
     Setattr(macro, kpp_swigmacro, "1");
   }
   symbols = Getattr(cpp, kpp_symbols);
-  if ((m1 = Getattr(symbols, macroname))) {
+  if ((m1 = macro_lookup(symbols, macroname))) {
     if (!Checkattr(m1, kpp_value, macrovalue)) {
       Swig_error(Getfile(macroname), Getline(macroname), "Macro '%s' redefined,\n", macroname);
       Swig_error(Getfile(m1), Getline(m1), "previous definition of '%s'.\n", macroname);
@@ -554,6 +565,7 @@ void Preprocessor_undef(const_String_or_char_ptr str) {
   Hash *symbols;
   assert(cpp);
   symbols = Getattr(cpp, kpp_symbols);
+  macro_lookup(symbols, str);
   Delattr(symbols, str);
 }
 
@@ -754,7 +766,7 @@ static String *expand_macro(String *name, List *args, String *line_file) {
     return 0;
 
   /* See if the name is actually defined */
-  macro = Getattr(symbols, name);
+  macro = macro_lookup(symbols, name);
   if (!macro)
     return 0;
 
@@ -1118,7 +1130,7 @@ static DOH *Preprocessor_replace(DOH *s) {
 	    }
 	    for (i = 0; i < lenargs; i++) {
 	      DOH *o = Getitem(args, i);
-	      if (!Getattr(symbols, o)) {
+	      if (!macro_lookup(symbols, o)) {
 		break;
 	      }
 	    }
@@ -1154,7 +1166,7 @@ static DOH *Preprocessor_replace(DOH *s) {
 	  Swig_warning(998, Getfile(s), Getline(s), "The %s preprocessor directive does not work in macros, try #if instead.\n", id);
 	  Append(ns, id);
 	  */
-	} else if ((m = Getattr(symbols, id))) {
+	} else if ((m = macro_lookup(symbols, id))) {
 	  /* See if the macro is defined in the preprocessor symbol table */
 	  DOH *args = 0;
 	  DOH *e;
@@ -1235,7 +1247,7 @@ static DOH *Preprocessor_replace(DOH *s) {
       Replaceall(fn, "\\", "\\\\");
       Printf(ns, "\"%s\"", fn);
       Delete(fn);
-    } else if (Getattr(symbols, id)) {
+    } else if (macro_lookup(symbols, id)) {
       DOH *e;
       /* Yes.  There is a macro here */
       /* See if the macro expects arguments */
@@ -1594,7 +1606,7 @@ String *Preprocessor_parse(String *s) {
 	  start_level = level;
 	  if (Len(value) > 0) {
 	    /* See if the identifier is in the hash table */
-	    if (!Getattr(symbols, value))
+	    if (!macro_lookup(symbols, value))
 	      allow = 0;
 	  } else {
 	    Swig_error(Getfile(s), Getline(id), "Missing identifier for #ifdef.\n");
@@ -1609,7 +1621,7 @@ String *Preprocessor_parse(String *s) {
 	  start_level = level;
 	  if (Len(value) > 0) {
 	    /* See if the identifier is in the hash table */
-	    if (Getattr(symbols, value))
+	    if (macro_lookup(symbols, value))
 	      allow = 0;
 	  } else {
 	    Swig_error(Getfile(s), Getline(id), "Missing identifier for #ifndef.\n");
@@ -1780,6 +1792,8 @@ String *Preprocessor_parse(String *s) {
 	      String *val = NewString(c + 7);
 	      String *nowarn = Preprocessor_replace(val);
 	      Swig_warnfilter(nowarn, 1);
+	      if (cache_pragmas)
+		Append(cache_pragmas, nowarn);
 	      Delete(nowarn);
 	      Delete(val);
 	    } else if (strncmp(c, "cpperraswarn=", 13) == 0) {
@@ -2063,3 +2077,471 @@ String *Preprocessor_parse(String *s) {
 
   return ns;
 }
+
+/* -----------------------------------------------------------------------------
+ * Preprocessor cache
+ *
+ * The library files included ahead of every interface file (swig.swg and the
+ * language configuration file) preprocess to the same text and leave the same
+ * macro changes behind on every run with the same options.  Preprocessor_parse_cached()
+ * keeps that result in a directory on disk so that later runs can skip it.
+ *
+ * An entry is found by a hash of its key: the input text, the macros defined so
+ * far, the include search path, the files already included and the preprocessor
+ * options.  The whole key is stored in the entry and compared, so a hash collision
+ * is just a miss.  The SWIGOPT_ macros are left out of the key as there is one for
+ * every command line option, including the output file name.  Instead every macro
+ * looked up, defined or undefined while preprocessing is recorded and the entry is
+ * only used if they all still have the same definitions.  The files read must also
+ * be unchanged, which is checked with their size and a hash of their content.
+ * A result that issued any warnings or errors is not cached so that they are
+ * reported again.
+ *
+ * An entry is a sequence of fields ending with a newline.  Strings are written as
+ * <length>:<text> and numbers as <number>; so no escaping is needed.
+ * ----------------------------------------------------------------------------- */
+
+#define CACHE_FORMAT "swig-ppcache-1"
+
+void Preprocessor_cache_dir(const_String_or_char_ptr dir) {
+  Delete(cache_dir);
+  cache_dir = dir ? NewString(dir) : 0;
+}
+
+static void cache_put(String *out, const_String_or_char_ptr s) {
+  Printf(out, "%d:", Len(s));
+  Append(out, s);
+}
+
+static void cache_putint(String *out, int n) {
+  Printf(out, "%d;", n);
+}
+
+static String *cache_get(char **pos, char *end) {
+  char *c = *pos;
+  long len = 0;
+  while (c < end && isdigit((unsigned char) *c))
+    len = len * 10 + (*c++ - '0');
+  if (c == end || *c != ':' || (end - c - 1) < len)
+    return 0;
+  *pos = c + 1 + len;
+  return NewStringWithSize(c + 1, (int) len);
+}
+
+static int cache_getint(char **pos, char *end, int *n) {
+  char *c = *pos;
+  int neg = 0;
+  *n = 0;
+  if (c < end && *c == '-') {
+    neg = 1;
+    c++;
+  }
+  while (c < end && isdigit((unsigned char) *c))
+    *n = *n * 10 + (*c++ - '0');
+  if (c == end || *c != ';')
+    return 0;
+  if (neg)
+    *n = -*n;
+  *pos = c + 1;
+  return 1;
+}
+
+/* Writes a macro definition, or that there is none if macro is 0 */
+static void cache_put_macro(String *out, Hash *macro) {
+  List *args;
+  int i;
+  cache_putint(out, macro ? 1 : 0);
+  if (!macro)
+    return;
+  args = Getattr(macro, kpp_args);
+  cache_put(out, Getfile(macro) ? Getfile(macro) : "");
+  cache_putint(out, Getline(macro));
+  cache_putint(out, Getattr(macro, kpp_varargs) ? 1 : 0);
+  cache_putint(out, Getattr(macro, kpp_swigmacro) ? 1 : 0);
+  cache_putint(out, args ? Len(args) : -1);
+  for (i = 0; args && i < Len(args); i++)
+    cache_put(out, Getitem(args, i));
+  cache_put(out, Getattr(macro, kpp_value));
+}
+
+/* Reads what cache_put_macro() wrote into *macro, returns 0 if the entry is broken */
+static int cache_get_macro(char **pos, char *end, String *name, Hash **macro) {
+  String *file, *value;
+  int defined, line, varargs, swigmacro, nargs, i;
+  *macro = 0;
+  if (!cache_getint(pos, end, &defined))
+    return 0;
+  if (!defined)
+    return 1;
+  file = cache_get(pos, end);
+  if (!file || !cache_getint(pos, end, &line) || !cache_getint(pos, end, &varargs) || !cache_getint(pos, end, &swigmacro)
+      || !cache_getint(pos, end, &nargs)) {
+    Delete(file);
+    return 0;
+  }
+  *macro = NewHash();
+  name = Copy(name);
+  Setfile(name, file);
+  Setline(name, line);
+  Setattr(*macro, kpp_name, name);
+  Setfile(*macro, file);
+  Setline(*macro, line);
+  Delete(name);
+  Delete(file);
+  if (varargs)
+    Setattr(*macro, kpp_varargs, "1");
+  if (swigmacro)
+    Setattr(*macro, kpp_swigmacro, "1");
+  if (nargs >= 0) {
+    List *args = NewList();
+    Setattr(*macro, kpp_args, args);
+    Delete(args);
+    for (i = 0; i < nargs; i++) {
+      String *arg = cache_get(pos, end);
+      if (!arg)
+	break;
+      Append(args, arg);
+      Delete(arg);
+    }
+    if (i < nargs) {
+      Delete(*macro);
+      *macro = 0;
+      return 0;
+    }
+  }
+  value = cache_get(pos, end);
+  if (!value) {
+    Delete(*macro);
+    *macro = 0;
+    return 0;
+  }
+  Setattr(*macro, kpp_value, value);
+  Delete(value);
+  return 1;
+}
+
+/* The definition of a macro, as written by cache_put_macro(), for comparisons */
+static String *cache_macro_signature(Hash *macro) {
+  String *sig = NewStringEmpty();
+  cache_put_macro(sig, macro);
+  return sig;
+}
+
+/* -----------------------------------------------------------------------------
+ * macro_lookup()
+ *
+ * Looks up a macro.  While a cache entry is being filled, also records the
+ * definition the first time a name is used so that the entry can be checked.
+ * ----------------------------------------------------------------------------- */
+
+static Hash *macro_lookup(Hash *symbols, const_String_or_char_ptr name) {
+  Hash *macro = Getattr(symbols, name);
+  if (cache_macros && !Getattr(cache_macros, name)) {
+    /* Copy the name as the caller's string may be reused */
+    String *key = NewString(name);
+    String *sig = cache_macro_signature(macro);
+    Setattr(cache_macros, key, sig);
+    Delete(sig);
+    Delete(key);
+  }
+  return macro;
+}
+
+/* Two independent 32 bit hashes (FNV-1a and sdbm) of some text, as 16 hex digits */
+static String *cache_hash(const_String_or_char_ptr s) {
+  const unsigned char *c = (const unsigned char *) Char(s);
+  int len = Len(s);
+  unsigned int h1 = 2166136261U;
+  unsigned int h2 = 0;
+  int i;
+  for (i = 0; i < len; i++) {
+    h1 = (h1 ^ c[i]) * 16777619U;
+    h2 = c[i] + (h2 << 6) + (h2 << 16) - h2;
+  }
+  return NewStringf("%08x%08x", h1 & 0xffffffffU, h2 & 0xffffffffU);
+}
+
+/* Size and hashes of the current content of a file, or 0 if it can't be read */
+static String *cache_file_signature(const_String_or_char_ptr filename) {
+  String *sig = 0;
+  FILE *f = fopen(Char(filename), "r");
+  if (f) {
+    String *content = Swig_read_file(f);
+    String *hash = cache_hash(content);
+    fclose(f);
+    sig = NewStringf("%d-%s", Len(content), hash);
+    Delete(hash);
+    Delete(content);
+  }
+  return sig;
+}
+
+static void cache_put_sorted_keys(String *out, Hash *h) {
+  List *keys = Keys(h);
+  int i;
+  SortList(keys, 0);
+  cache_putint(out, Len(keys));
+  for (i = 0; i < Len(keys); i++)
+    cache_put(out, Getitem(keys, i));
+  Delete(keys);
+}
+
+/* Everything the result of preprocessing s depends on, other than the files read and the SWIGOPT_ macros */
+static String *cache_key(String *s) {
+  String *key = NewStringEmpty();
+  List *path = Swig_search_path();
+  Hash *symbols = Getattr(cpp, kpp_symbols);
+  List *names = Keys(symbols);
+  int i;
+  cache_put(key, CACHE_FORMAT);
+  cache_putint(key, include_all);
+  cache_putint(key, import_all);
+  cache_putint(key, ignore_missing);
+  cache_putint(key, error_as_warning);
+  cache_putint(key, single_include);
+  cache_putint(key, Swig_get_push_dir());
+  cache_putint(key, Len(path));
+  for (i = 0; i < Len(path); i++)
+    cache_put(key, Getitem(path, i));
+  cache_put_sorted_keys(key, included_files);
+  SortList(names, 0);
+  for (i = 0; i < Len(names); i++) {
+    String *name = Getitem(names, i);
+    if (Strncmp(name, "SWIGOPT_", 8) != 0) {
+      cache_put(key, name);
+      cache_put_macro(key, Getattr(symbols, name));
+    }
+  }
+  Delete(names);
+  cache_put(key, Getfile(s) ? Getfile(s) : "");
+  cache_putint(key, Getline(s));
+  cache_put(key, s);
+  Delete(path);
+  return key;
+}
+
+static String *cache_load(String *filename, String *key) {
+  Hash *symbols = Getattr(cpp, kpp_symbols);
+  String *data;
+  String *ns = 0;
+  String *stored_key = 0;
+  String *ns_file = 0;
+  List *files = NewList();
+  List *included = NewList();
+  List *pragmas = NewList();
+  List *names = NewList();
+  List *macros = NewList();
+  char *pos, *end;
+  int n, i, ns_line, cpperraswarn;
+  FILE *f = fopen(Char(filename), "rb");
+  if (!f) {
+    data = 0;
+    goto fail;
+  }
+  data = Swig_read_file(f);
+  fclose(f);
+  pos = Char(data);
+  end = pos + Len(data);
+
+  stored_key = cache_get(&pos, end);
+  if (!stored_key || !Equal(stored_key, key))
+    goto fail;
+
+  /* The files read, which must be unchanged */
+  if (!cache_getint(&pos, end, &n))
+    goto fail;
+  for (i = 0; i < n; i++) {
+    String *file = cache_get(&pos, end);
+    String *sig = file ? cache_get(&pos, end) : 0;
+    String *current = sig ? cache_file_signature(file) : 0;
+    int ok = current && Equal(current, sig);
+    if (file)
+      Append(files, file);
+    Delete(current);
+    Delete(sig);
+    Delete(file);
+    if (!ok)
+      goto fail;
+  }
+
+  /* The macros used, which must have the same definitions, and their definitions afterwards */
+  if (!cache_getint(&pos, end, &n))
+    goto fail;
+  for (i = 0; i < n; i++) {
+    String *name = cache_get(&pos, end);
+    String *sig = name ? cache_get(&pos, end) : 0;
+    String *current = sig ? cache_macro_signature(Getattr(symbols, name)) : 0;
+    Hash *macro = 0;
+    int ok = current && Equal(current, sig) && cache_get_macro(&pos, end, name, &macro);
+    if (ok) {
+      Append(names, name);
+      Append(macros, macro ? macro : None);
+    }
+    Delete(macro);
+    Delete(current);
+    Delete(sig);
+    Delete(name);
+    if (!ok)
+      goto fail;
+  }
+
+  ns = cache_get(&pos, end);
+  ns_file = ns ? cache_get(&pos, end) : 0;
+  if (!ns_file || !cache_getint(&pos, end, &ns_line))
+    goto fail;
+  if (!cache_getint(&pos, end, &n))
+    goto fail;
+  for (i = 0; i < n; i++) {
+    String *file = cache_get(&pos, end);
+    if (!file)
+      goto fail;
+    Append(included, file);
+    Delete(file);
+  }
+  if (!cache_getint(&pos, end, &n))
+    goto fail;
+  for (i = 0; i < n; i++) {
+    String *pragma = cache_get(&pos, end);
+    if (!pragma)
+      goto fail;
+    Append(pragmas, pragma);
+    Delete(pragma);
+  }
+  if (!cache_getint(&pos, end, &cpperraswarn) || pos + 1 != end || *pos != '\n')
+    goto fail;
+
+  /* The entry is complete, so apply the state it records */
+  if (Len(ns_file))
+    Setfile(ns, ns_file);
+  Setline(ns, ns_line);
+  if (!dependencies)
+    dependencies = NewList();
+  for (i = 0; i < Len(files); i++)
+    Append(dependencies, Getitem(files, i));
+  for (i = 0; i < Len(included); i++)
+    Setattr(included_files, Getitem(included, i), Getitem(included, i));
+  for (i = 0; i < Len(names); i++) {
+    Hash *macro = Getitem(macros, i);
+    if (macro != None)
+      Setattr(symbols, Getitem(names, i), macro);
+    else
+      Delattr(symbols, Getitem(names, i));
+  }
+  for (i = 0; i < Len(pragmas); i++)
+    Swig_warnfilter(Getitem(pragmas, i), 1);
+  error_as_warning = cpperraswarn;
+  goto done;
+
+fail:
+  Delete(ns);
+  ns = 0;
+done:
+  Delete(macros);
+  Delete(names);
+  Delete(ns_file);
+  Delete(stored_key);
+  Delete(pragmas);
+  Delete(included);
+  Delete(files);
+  Delete(data);
+  return ns;
+}
+
+static void cache_store(String *filename, String *key, String *ns, int first_dependency) {
+  Hash *symbols = Getattr(cpp, kpp_symbols);
+  String *out = NewStringEmpty();
+  String *tmpname = 0;
+  List *names;
+  FILE *f;
+  int i;
+
+  cache_put(out, key);
+  cache_putint(out, Len(dependencies) - first_dependency);
+  for (i = first_dependency; i < Len(dependencies); i++) {
+    String *file = Getitem(dependencies, i);
+    String *sig = cache_file_signature(file);
+    if (!sig)
+      goto done;
+    cache_put(out, file);
+    cache_put(out, sig);
+    Delete(sig);
+  }
+  names = Keys(cache_macros);
+  SortList(names, 0);
+  cache_putint(out, Len(names));
+  for (i = 0; i < Len(names); i++) {
+    String *name = Getitem(names, i);
+    cache_put(out, name);
+    cache_put(out, Getattr(cache_macros, name));
+    cache_put_macro(out, Getattr(symbols, name));
+  }
+  Delete(names);
+  cache_put(out, ns);
+  cache_put(out, Getfile(ns) ? Getfile(ns) : "");
+  cache_putint(out, Getline(ns));
+  cache_put_sorted_keys(out, included_files);
+  cache_putint(out, Len(cache_pragmas));
+  for (i = 0; i < Len(cache_pragmas); i++)
+    cache_put(out, Getitem(cache_pragmas, i));
+  cache_putint(out, error_as_warning);
+  Putc('\n', out);
+
+  /* Write to a temporary file of this process first so that other processes never
+     see a partial entry, even when several of them store the same entry at once */
+  tmpname = NewStringf("%s.%ld.tmp", filename, (long)getpid());
+  f = fopen(Char(tmpname), "wb");
+  if (f) {
+    int ok = (int)fwrite(Char(out), 1, Len(out), f) == Len(out);
+    ok = (fclose(f) == 0) && ok;
+    if (ok) {
+#if defined(_WIN32)
+      /* rename() does not replace an existing file */
+      remove(Char(filename));
+#endif
+      ok = rename(Char(tmpname), Char(filename)) == 0;
+    }
+    if (!ok)
+      remove(Char(tmpname));
+  }
+
+done:
+  Delete(tmpname);
+  Delete(out);
+}
+
+/* -----------------------------------------------------------------------------
+ * Preprocessor_parse_cached()
+ *
+ * Same as Preprocessor_parse(), but uses the cache set by Preprocessor_cache_dir().
+ * ----------------------------------------------------------------------------- */
+
+String *Preprocessor_parse_cached(String *s) {
+  String *key, *hash, *filename;
+  String *ns;
+
+  if (!cache_dir)
+    return Preprocessor_parse(s);
+
+  key = cache_key(s);
+  hash = cache_hash(key);
+  filename = NewStringf("%s%sswigpp-%s.cache", cache_dir, SWIG_FILE_DELIMITER, hash);
+  ns = cache_load(filename, key);
+  if (!ns) {
+    int first_dependency = dependencies ? Len(dependencies) : 0;
+    int nwarnings = Swig_warn_count();
+    int nerrors = Swig_error_count();
+    cache_macros = NewHash();
+    cache_pragmas = NewList();
+    ns = Preprocessor_parse(s);
+    if (Swig_warn_count() == nwarnings && Swig_error_count() == nerrors && dependencies)
+      cache_store(filename, key, ns, first_dependency);
+    Delete(cache_pragmas);
+    cache_pragmas = 0;
+    Delete(cache_macros);
+    cache_macros = 0;
+  }
+  Delete(filename);
+  Delete(hash);
+  Delete(key);
+  return ns;
+}
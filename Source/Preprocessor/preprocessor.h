@@ -26,6 +26,8 @@ extern "C" {
   extern void Preprocessor_init(void);
   extern void Preprocessor_delete(void);
   extern String *Preprocessor_parse(String *s);
+  extern void Preprocessor_cache_dir(const_String_or_char_ptr dir);
+  extern String *Preprocessor_parse_cached(String *s);
   extern void Preprocessor_include_all(int);
   extern void Preprocessor_import_all(int);
   extern void Preprocessor_ignore_missing(int);
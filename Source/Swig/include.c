@@ -324,6 +324,38 @@ File *Swig_filebyname(const_String_or_char_ptr filename) {
   return Getattr(named_files, filename);
 }
 
+/* -----------------------------------------------------------------------------
+ * Swig_spill_sections_set()
+ *
+ * Turn on keeping the large output sections in temporary files instead of
+ * memory, see Swig_new_section()
+ * ----------------------------------------------------------------------------- */
+
+static int spill_sections = 0;
+
+void Swig_spill_sections_set(int spill) {
+  spill_sections = spill;
+}
+
+/* -----------------------------------------------------------------------------
+ * Swig_new_section()
+ *
+ * Create a buffer for an output section, such as the wrapper code, which is
+ * copied into the output file with Dump() or Wrapper_pretty_print() once all the
+ * code has been generated.  Sections may only be appended to with Printf(),
+ * Printv(), Write() or Dump().  When spilling is on, the section is a temporary
+ * file so that the generated code does not need to be held in memory.
+ * ----------------------------------------------------------------------------- */
+
+File *Swig_new_section(void) {
+  if (spill_sections) {
+    File *f = NewTempFile();
+    if (f)
+      return f;
+  }
+  return NewStringEmpty();
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_file_extension()
  *
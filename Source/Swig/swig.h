@@ -202,12 +202,14 @@ extern "C" {
   extern Typetab *SwigType_pop_scope(void);
   extern Typetab *SwigType_set_scope(Typetab *h);
   extern void SwigType_print_scope(void);
+  extern void SwigType_print_cache_stats(void);
   extern SwigType *SwigType_typedef_resolve(const SwigType *t);
   extern SwigType *SwigType_typedef_resolve_all(const SwigType *t);
   extern SwigType *SwigType_typedef_qualified(const SwigType *t);
   extern int SwigType_istypedef(const SwigType *t);
   extern int SwigType_isclass(const SwigType *t);
   extern void SwigType_attach_symtab(Symtab *syms);
+  extern void SwigType_symbol_added(const_String_or_char_ptr name);
   extern void SwigType_remember(const SwigType *t);
   extern void SwigType_remember_clientdata(const SwigType *t, const_String_or_char_ptr clientdata);
   extern void SwigType_remember_mangleddata(String *mangled, const_String_or_char_ptr clientdata);
@@ -405,6 +407,8 @@ extern int        ParmList_is_compactdefargs(ParmList *p);
   extern void Swig_typemap_replace_embedded_typemap(String *s, Node *file_line_node);
   extern void Swig_typemap_debug(void);
   extern void Swig_typemap_search_debug_set(void);
+  extern void Swig_typemap_search_debug_stats(void);
+  extern void Swig_typemap_search_cache_flush(void);
   extern void Swig_typemap_used_debug_set(void);
   extern void Swig_typemap_register_debug_set(void);
 
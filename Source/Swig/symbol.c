@@ -549,6 +549,9 @@ void Swig_symbol_cadd(const_String_or_char_ptr name, Node *n) {
   if (!name)
     return;
 
+  /* Qualified types may have looked up the name before it was added */
+  SwigType_symbol_added(name);
+
   if (SwigType_istemplate(name)) {
     String *cname = NewString(name);
     String *dname = Swig_symbol_template_deftype(cname, 0);
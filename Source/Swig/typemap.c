@@ -61,6 +61,13 @@ static void replace_embedded_typemap(String *s, ParmList *parm_sublist, Wrapper
 
 static Hash *typemaps;
 
+/* Cache of typemap_search() results. Any change to the typemaps or to the
+   typedefs in the type system discards the whole cache. */
+static Hash *typemap_search_cache = 0;
+static int typemap_search_cache_hits = 0;
+static int typemap_search_cache_misses = 0;
+static int typemap_search_cache_flushes = 0;
+
 /* -----------------------------------------------------------------------------
  * typemap_identifier_fix()
  *
@@ -153,6 +160,22 @@ static void set_typemap(const SwigType *type, Hash **tmhash) {
 
 void Swig_typemap_init() {
   typemaps = NewHash();
+  Swig_typemap_search_cache_flush();
+}
+
+/* -----------------------------------------------------------------------------
+ * Swig_typemap_search_cache_flush()
+ *
+ * Discard all cached typemap search results. Called whenever the typemaps
+ * change and by the type system whenever typedefs or type scopes change.
+ * ----------------------------------------------------------------------------- */
+
+void Swig_typemap_search_cache_flush(void) {
+  if (typemap_search_cache) {
+    Delete(typemap_search_cache);
+    typemap_search_cache = 0;
+    typemap_search_cache_flushes++;
+  }
 }
 
 static String *typemap_method_name(const_String_or_char_ptr tmap_method) {
@@ -204,6 +227,8 @@ static void typemap_register(const_String_or_char_ptr tmap_method, ParmList *par
       Swig_print_node(parms);
   }
 
+  Swig_typemap_search_cache_flush();
+
   tm_method = typemap_method_name(tmap_method);
 
   /* Register the first type in the parameter list */
@@ -395,6 +420,8 @@ void Swig_typemap_clear(const_String_or_char_ptr tmap_method, ParmList *parms) {
   String *multi_tmap_method;
   Hash *tm = 0;
 
+  Swig_typemap_search_cache_flush();
+
   /* This might not work */
   multi_tmap_method = NewString(tmap_method);
   p = parms;
@@ -569,6 +596,8 @@ void Swig_typemap_clear_apply(Parm *parms) {
   Hash *tm;
   String *name;
 
+  Swig_typemap_search_cache_flush();
+
   /* Create a type signature of the parameters */
   tsig = NewStringEmpty();
   p = parms;
@@ -682,14 +711,14 @@ ret_result:
 }
 
 /* -----------------------------------------------------------------------------
- * typemap_search()
+ * typemap_search_uncached()
  *
  * Search for a typemap match. This is where the typemap pattern matching rules 
  * are implemented... tries to find the most specific typemap that includes a 
  * 'code' attribute.
  * ----------------------------------------------------------------------------- */
 
-static Hash *typemap_search(const_String_or_char_ptr tmap_method, SwigType *type, const_String_or_char_ptr name, const_String_or_char_ptr qualifiedname, SwigType **matchtype, Node *node) {
+static Hash *typemap_search_uncached(const String *tm_method, const_String_or_char_ptr tmap_method, SwigType *type, const String *cname, const String *cqualifiedname, SwigType **matchtype, Node *node) {
   Hash *result = 0;
   Hash *tm;
   Hash *backup = 0;
@@ -697,16 +726,8 @@ static Hash *typemap_search(const_String_or_char_ptr tmap_method, SwigType *type
   SwigType *ctype = 0;
   SwigType *ctype_unstripped = 0;
   int isarray;
-  const String *cname = 0;
-  const String *cqualifiedname = 0;
-  String *tm_method = typemap_method_name(tmap_method);
   int debug_display = (in_typemap_search_multi == 0) && typemap_search_debug;
 
-  if ((name) && Len(name))
-    cname = name;
-  if ((qualifiedname) && Len(qualifiedname))
-    cqualifiedname = qualifiedname;
-
   if (debug_display) {
     String *typestr = SwigType_str(type, cqualifiedname ? cqualifiedname : cname);
     Swig_diagnostic(Getfile(node), Getline(node), "Searching for a suitable '%s' typemap for: %s\n", tmap_method, typestr);
@@ -799,6 +820,65 @@ ret_result:
   return result;
 }
 
+/* -----------------------------------------------------------------------------
+ * typemap_search()
+ *
+ * Search for a typemap match, see typemap_search_uncached(). Identical searches
+ * recur for nearly every parameter of every wrapped function, so the results are
+ * cached, keyed on the typemap method, type, names and the current symbol table
+ * (which affects how template types are qualified). The searches are always done
+ * in full when displaying typemap search debugging information, the cache then
+ * only keeps count of the hits and misses it would have had.
+ * ----------------------------------------------------------------------------- */
+
+static Hash *typemap_search(const_String_or_char_ptr tmap_method, SwigType *type, const_String_or_char_ptr name, const_String_or_char_ptr qualifiedname, SwigType **matchtype, Node *node) {
+  Hash *result;
+  Hash *entry;
+  String *key;
+  SwigType *mtype = 0;
+  const String *cname = 0;
+  const String *cqualifiedname = 0;
+  String *tm_method = typemap_method_name(tmap_method);
+
+  if ((name) && Len(name))
+    cname = name;
+  if ((qualifiedname) && Len(qualifiedname))
+    cqualifiedname = qualifiedname;
+
+  if (!typemap_search_cache)
+    typemap_search_cache = NewHash();
+  key = NewStringf("%p\t%s\t%s\t%s\t%s", Swig_symbol_current(), tm_method, type, cname ? cname : "", cqualifiedname ? cqualifiedname : "");
+  entry = Getattr(typemap_search_cache, key);
+  if (entry) {
+    typemap_search_cache_hits++;
+    if (!typemap_search_debug) {
+      Delete(key);
+      if (matchtype)
+	*matchtype = Copy(Getattr(entry, "matchtype"));
+      return Getattr(entry, "typemap");
+    }
+  } else {
+    typemap_search_cache_misses++;
+  }
+
+  result = typemap_search_uncached(tm_method, tmap_method, type, cname, cqualifiedname, &mtype, node);
+
+  entry = NewHash();
+  if (result)
+    Setattr(entry, "typemap", result);
+  if (mtype)
+    Setattr(entry, "matchtype", mtype);
+  Setattr(typemap_search_cache, key, entry);
+  Delete(entry);
+  Delete(key);
+
+  if (matchtype)
+    *matchtype = mtype;
+  else
+    Delete(mtype);
+  return result;
+}
+
 
 /* -----------------------------------------------------------------------------
  * typemap_search_multi()
@@ -2123,6 +2203,22 @@ void Swig_typemap_search_debug_set(void) {
   typemap_search_debug = 1;
 }
 
+/* -----------------------------------------------------------------------------
+ * Swig_typemap_search_debug_stats()
+ *
+ * Display the typemap search cache statistics
+ * ----------------------------------------------------------------------------- */
+
+void Swig_typemap_search_debug_stats(void) {
+  int searches = typemap_search_cache_hits + typemap_search_cache_misses;
+  Printf(stdout, "---[ typemap search cache ]--------------------------------------------------\n");
+  Printf(stdout, "  Searches : %d\n", searches);
+  Printf(stdout, "  Hits     : %d (%.1f%%)\n", typemap_search_cache_hits, searches ? 100.0 * typemap_search_cache_hits / searches : 0.0);
+  Printf(stdout, "  Misses   : %d\n", typemap_search_cache_misses);
+  Printf(stdout, "  Flushes  : %d\n", typemap_search_cache_flushes);
+  Printf(stdout, "-----------------------------------------------------------------------------\n");
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_typemap_used_debug_set()
  *
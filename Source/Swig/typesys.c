@@ -153,11 +153,34 @@ static Hash *current_symtab = 0;	/* Current symbol table
 static Typetab *global_scope = 0;	/* The global scope                             */
 static Hash *scopes = 0;	/* Hash table containing fully qualified scopes */
 
-/* Performance optimization */
+/* Performance optimization.
+ *
+ * The results of SwigType_typedef_resolve(), SwigType_typedef_resolve_all() and
+ * SwigType_typedef_qualified() are cached.  A separate set of caches is kept for
+ * each scope, as the results depend on the scope the lookup is made from.  While
+ * a result is being computed, every typetab name and scope name that is looked
+ * up is recorded in cache_lookups.  These names are stored with the cache entry
+ * and in cache_users, so that a new typedef or scope only invalidates the cache
+ * entries that looked up the same name rather than flushing all the caches.
+ * Results which ran into a scope that was already being searched depend on the
+ * lookup in progress and are not cached. */
 #define SWIG_TYPEDEF_RESOLVE_CACHE 
 static Hash *typedef_resolve_cache = 0;
 static Hash *typedef_all_cache = 0;
 static Hash *typedef_qualified_cache = 0;
+static Hash *scope_caches = 0;	/* Caches for each scope                        */
+static Hash *cache_users = 0;	/* Looked up name -> list of (cache, key) pairs */
+static Hash *cache_lookups = 0;	/* Names looked up by the current computation   */
+static String *cache_uncacheable = 0;	/* Recorded for results that must not be cached */
+
+static int cache_resolve_hits = 0;
+static int cache_resolve_misses = 0;
+static int cache_all_hits = 0;
+static int cache_all_misses = 0;
+static int cache_qualified_hits = 0;
+static int cache_qualified_misses = 0;
+static int cache_invalidations = 0;
+static int cache_flushes = 0;
 
 static Typetab *SwigType_find_scope(Typetab *s, const SwigType *nameprefix);
 
@@ -180,10 +203,194 @@ int Swig_value_wrapper_mode(int mode) {
 }
 
 
-static void flush_cache() {
-  typedef_resolve_cache = 0;
-  typedef_all_cache = 0;
-  typedef_qualified_cache = 0;
+/* -----------------------------------------------------------------------------
+ * select_cache()
+ *
+ * Makes the caches for the current scope the active caches.
+ * ----------------------------------------------------------------------------- */
+
+static void select_cache(void) {
+  String *key = NewStringf("%p", (void *) current_scope);
+  Hash *caches = Getattr(scope_caches, key);
+  if (!caches) {
+    Hash *resolve = NewHash();
+    Hash *all = NewHash();
+    Hash *qualified = NewHash();
+    caches = NewHash();
+    Setattr(caches, "resolve", resolve);
+    Setattr(caches, "all", all);
+    Setattr(caches, "qualified", qualified);
+    Setattr(scope_caches, key, caches);
+    Delete(resolve);
+    Delete(all);
+    Delete(qualified);
+    Delete(caches);
+  }
+  typedef_resolve_cache = Getattr(caches, "resolve");
+  typedef_all_cache = Getattr(caches, "all");
+  typedef_qualified_cache = Getattr(caches, "qualified");
+  Delete(key);
+}
+
+/* -----------------------------------------------------------------------------
+ * flush_cache()
+ *
+ * Discards the caches for all scopes.
+ * ----------------------------------------------------------------------------- */
+
+static void flush_cache(void) {
+  if (!cache_uncacheable)
+    cache_uncacheable = NewString("$uncacheable");
+  Delete(scope_caches);
+  Delete(cache_users);
+  scope_caches = NewHash();
+  cache_users = NewHash();
+  cache_flushes++;
+  select_cache();
+  /* Typemap searches resolve typedefs too */
+  Swig_typemap_search_cache_flush();
+}
+
+/* -----------------------------------------------------------------------------
+ * scope_token()
+ *
+ * Name recorded when the inherit or using lists of a scope are looked at.  A
+ * clash with a name in a typetab only causes some extra invalidation.
+ * ----------------------------------------------------------------------------- */
+
+static String *scope_token(Typetab *s) {
+  String *qname = Getattr(s, "qname");
+  return qname ? qname : (String *) Getattr(s, "name");
+}
+
+/* -----------------------------------------------------------------------------
+ * cache_record()
+ *
+ * Records a name looked up while computing a cached result.
+ * ----------------------------------------------------------------------------- */
+
+static void cache_record(const String *name) {
+  if (cache_lookups && name && !Getattr(cache_lookups, name)) {
+    String *k = NewString(name);
+    Setattr(cache_lookups, k, k);
+    Delete(k);
+  }
+}
+
+/* -----------------------------------------------------------------------------
+ * cache_record_symbol()
+ *
+ * Records a name looked up in the C symbol tables while computing a cached
+ * result.  Symbols are added by their unqualified name, so only the last part
+ * of the name is recorded.
+ * ----------------------------------------------------------------------------- */
+
+static void cache_record_symbol(const String *name) {
+  if (cache_lookups) {
+    String *last = Swig_scopename_last(name);
+    cache_record(last);
+    Delete(last);
+  }
+}
+
+/* -----------------------------------------------------------------------------
+ * cache_replay()
+ *
+ * A cached result was used while computing another result, so the other result
+ * depends on the same names.
+ * ----------------------------------------------------------------------------- */
+
+static void cache_replay(Hash *entry) {
+  if (cache_lookups) {
+    Iterator ki;
+    for (ki = First(Getattr(entry, "deps")); ki.key; ki = Next(ki)) {
+      cache_record(ki.key);
+    }
+  }
+}
+
+/* -----------------------------------------------------------------------------
+ * cache_begin()
+ *
+ * Starts recording the names looked up for a new result.  Returns the names
+ * recorded so far for an enclosing computation, which must be passed to
+ * cache_store().
+ * ----------------------------------------------------------------------------- */
+
+static Hash *cache_begin(void) {
+  Hash *saved = cache_lookups;
+  cache_lookups = NewHash();
+  return saved;
+}
+
+/* -----------------------------------------------------------------------------
+ * cache_store()
+ *
+ * Adds an entry to a cache and registers it against the names it depends on.
+ * ----------------------------------------------------------------------------- */
+
+static void cache_store(Hash *cache, const SwigType *t, Hash *entry, Hash *saved) {
+  String *key = NewString(t);
+  Iterator ki;
+  int store = !Getattr(cache_lookups, cache_uncacheable);
+  if (store) {
+    Setattr(entry, "deps", cache_lookups);
+    Setattr(cache, key, entry);
+  }
+  for (ki = First(cache_lookups); ki.key; ki = Next(ki)) {
+    if (store) {
+      List *users = Getattr(cache_users, ki.key);
+      if (!users) {
+	users = NewList();
+	Setattr(cache_users, ki.key, users);
+	Delete(users);
+      }
+      Append(users, cache);
+      Append(users, key);
+    }
+    if (saved)
+      Setattr(saved, ki.key, ki.key);
+  }
+  Delete(key);
+  Delete(cache_lookups);
+  cache_lookups = saved;
+}
+
+/* -----------------------------------------------------------------------------
+ * cache_invalidate()
+ *
+ * Removes the cache entries which looked up name.
+ * ----------------------------------------------------------------------------- */
+
+static void cache_invalidate(const_String_or_char_ptr name) {
+  List *users = Getattr(cache_users, name);
+  if (users) {
+    int i;
+    int len = Len(users);
+    for (i = 0; i + 1 < len; i += 2) {
+      if (Delattr(Getitem(users, i), Getitem(users, i + 1)))
+	cache_invalidations++;
+    }
+    Delattr(cache_users, name);
+  }
+  Swig_typemap_search_cache_flush();
+}
+
+/* -----------------------------------------------------------------------------
+ * SwigType_symbol_added()
+ *
+ * Called when a symbol is added to a C symbol table.  Removes the cache entries
+ * which looked up the name in the symbol tables.
+ * ----------------------------------------------------------------------------- */
+
+void SwigType_symbol_added(const_String_or_char_ptr name) {
+  String *last;
+  if (!cache_users)
+    return;
+  last = Swig_scopename_last(name);
+  if (Getattr(cache_users, last))
+    cache_invalidate(last);
+  Delete(last);
 }
 
 /* Initialize the scoping system */
@@ -204,6 +411,7 @@ void SwigType_typesystem_init() {
   current_symtab = 0;
   scopes = NewHash();
   Setattr(scopes, "", current_scope);
+  flush_cache();
 }
 
 
@@ -234,7 +442,7 @@ int SwigType_typedef(const SwigType *type, const_String_or_char_ptr name) {
     }
   }
   Setattr(current_typetab, name, type);
-  flush_cache();
+  cache_invalidate(name);
   return 0;
 }
 
@@ -253,8 +461,8 @@ int SwigType_typedef_class(const_String_or_char_ptr name) {
   cname = NewString(name);
   Setmeta(cname, "class", "1");
   Setattr(current_typetab, cname, cname);
+  cache_invalidate(cname);
   Delete(cname);
-  flush_cache();
   return 0;
 }
 
@@ -311,6 +519,8 @@ void SwigType_new_scope(const_String_or_char_ptr name) {
     /*
     Printf(stdout, "SwigType_new_scope stripped %s %s\n", qname, stripped_qname);
     */
+    cache_invalidate(stripped_qname);
+    cache_invalidate(qname);
     Delete(stripped_qname);
   }
 #else
@@ -323,7 +533,7 @@ void SwigType_new_scope(const_String_or_char_ptr name) {
   current_scope = s;
   current_typetab = ttab;
   current_symtab = 0;
-  flush_cache();
+  select_cache();
 }
 
 /* -----------------------------------------------------------------------------
@@ -351,6 +561,7 @@ void SwigType_inherit_scope(Typetab *scope) {
       return;
   }
   Append(inherits, scope);
+  cache_invalidate(scope_token(current_scope));
 }
 
 /* -----------------------------------------------------------------------------
@@ -368,7 +579,8 @@ void SwigType_scope_alias(String *aliasname, Typetab *ttab) {
   }
   Append(q, aliasname);
   Setattr(scopes, q, ttab);
-  flush_cache();
+  cache_invalidate(q);
+  Delete(q);
 }
 
 /* -----------------------------------------------------------------------------
@@ -397,7 +609,7 @@ void SwigType_using_scope(Typetab *scope) {
     }
     Append(ulist, scope);
   }
-  flush_cache();
+  cache_invalidate(scope_token(current_scope));
 }
 
 /* -----------------------------------------------------------------------------
@@ -415,7 +627,7 @@ Typetab *SwigType_pop_scope() {
   current_scope = t;
   current_typetab = Getattr(t, "typetab");
   current_symtab = Getattr(t, "symtab");
-  flush_cache();
+  select_cache();
   return old;
 }
 
@@ -432,7 +644,7 @@ Typetab *SwigType_set_scope(Typetab *t) {
   current_scope = t;
   current_typetab = Getattr(t, "typetab");
   current_symtab = Getattr(t, "symtab");
-  flush_cache();
+  select_cache();
   return old;
 }
 
@@ -445,6 +657,8 @@ Typetab *SwigType_set_scope(Typetab *t) {
 void SwigType_attach_symtab(Symtab *sym) {
   Setattr(current_scope, "symtab", sym);
   current_symtab = sym;
+  /* Qualified types depend on the symbol table */
+  Clear(typedef_qualified_cache);
 }
 
 /* -----------------------------------------------------------------------------
@@ -479,6 +693,29 @@ void SwigType_print_scope(void) {
   Printf(stdout, "SCOPES finish =======================================\n");
 }
 
+/* -----------------------------------------------------------------------------
+ * SwigType_print_cache_stats()
+ *
+ * Debugging function for printing out the typedef resolution cache statistics
+ * ----------------------------------------------------------------------------- */
+
+static void print_cache_stats(const char *name, int hits, int misses) {
+  int lookups = hits + misses;
+  Printf(stdout, "  %-11s: %d lookups, %d hits (%.1f%%), %d misses\n", name, lookups, hits, lookups ? 100.0 * hits / lookups : 0.0, misses);
+}
+
+void SwigType_print_cache_stats(void) {
+  Printf(stdout, "---[ typedef resolution caches ]---------------------------------------------\n");
+  print_cache_stats("resolve", cache_resolve_hits, cache_resolve_misses);
+  print_cache_stats("resolve_all", cache_all_hits, cache_all_misses);
+  print_cache_stats("qualified", cache_qualified_hits, cache_qualified_misses);
+  Printf(stdout, "  Scopes     : %d\n", Len(scope_caches));
+  Printf(stdout, "  Invalidated: %d\n", cache_invalidations);
+  Printf(stdout, "  Flushes    : %d\n", cache_flushes);
+  Printf(stdout, "-----------------------------------------------------------------------------\n");
+}
+
+
 static Typetab *SwigType_find_scope(Typetab *s, const SwigType *nameprefix) {
   Typetab *ss;
   Typetab *s_orig = s;
@@ -486,8 +723,12 @@ static Typetab *SwigType_find_scope(Typetab *s, const SwigType *nameprefix) {
   static int check_parent = 1;
   int is_template = 0;
 
-  if (Getmark(s))
+  if (!check_parent)
+    cache_record(cache_uncacheable);
+  if (Getmark(s)) {
+    cache_record(cache_uncacheable);
     return 0;
+  }
   Setmark(s, 1);
 
   is_template = SwigType_istemplate(nameprefix);
@@ -505,10 +746,12 @@ static Typetab *SwigType_find_scope(Typetab *s, const SwigType *nameprefix) {
     } else {
       full = NewString(nameprefix);
     }
+    cache_record(full);
     s = Getattr(scopes, full);
     if (!s && is_template) {
       /* try look up scope with all the unary scope operators within the template parameter list removed */
       SwigType *full_stripped = SwigType_remove_global_scope_prefix(full);
+      cache_record(full_stripped);
       s = Getattr(scopes, full_stripped);
       Delete(full_stripped);
     }
@@ -522,6 +765,7 @@ static Typetab *SwigType_find_scope(Typetab *s, const SwigType *nameprefix) {
     if (!s) {
       /* Check inheritance */
       List *inherit;
+      cache_record(scope_token(ss));
       inherit = Getattr(ss, "using");
       if (inherit) {
 	Typetab *ttab;
@@ -573,16 +817,20 @@ static SwigType *_typedef_resolve(Typetab *s, String *base, int look_parent) {
   /* if (!s) return 0; *//* now is checked bellow */
   /* Printf(stdout,"Typetab %s : %s\n", Getattr(s,"name"), base);  */
 
-  if (!Getmark(s)) {
+  if (Getmark(s)) {
+    cache_record(cache_uncacheable);
+  } else {
     Setmark(s, 1);
 
     ttab = Getattr(s, "typetab");
+    cache_record(base);
     type = Getattr(ttab, base);
     if (type) {
       resolved_scope = s;
       Setmark(s, 0);
     } else {
       /* Hmmm. Not found in my scope.  It could be in an inherited scope */
+      cache_record(scope_token(s));
       inherit = Getattr(s, "inherit");
       if (inherit) {
 	int i, len;
@@ -689,18 +937,24 @@ SwigType *SwigType_typedef_resolve(const SwigType *t) {
   String *namebase = 0;
   String *nameprefix = 0, *rnameprefix = 0;
   int newtype = 0;
+#ifdef SWIG_TYPEDEF_RESOLVE_CACHE
+  Hash *entry;
+  Hash *saved_lookups;
+#endif
 
   resolved_scope = 0;
 
 #ifdef SWIG_TYPEDEF_RESOLVE_CACHE
-  if (!typedef_resolve_cache) {
-    typedef_resolve_cache = NewHash();
-  }
-  r = Getattr(typedef_resolve_cache, t);
-  if (r) {
-    resolved_scope = Getmeta(r, "scope");
-    return Copy(r);
-  }
+  entry = Getattr(typedef_resolve_cache, t);
+  if (entry) {
+    cache_resolve_hits++;
+    cache_replay(entry);
+    resolved_scope = Getattr(entry, "scope");
+    r = Getattr(entry, "type");
+    return r ? Copy(r) : 0;
+  }
+  cache_resolve_misses++;
+  saved_lookups = cache_begin();
 #endif
 
   base = SwigType_base(t);
@@ -719,6 +973,7 @@ SwigType *SwigType_typedef_resolve(const SwigType *t) {
       Delitem(base, 0);
     }
     /* Do a quick check in the local scope */
+    cache_record(base);
     type = Getattr(ttab, base);
     if (type) {
       resolved_scope = s;
@@ -979,18 +1234,17 @@ SwigType *SwigType_typedef_resolve(const SwigType *t) {
 
 return_result:
 #ifdef SWIG_TYPEDEF_RESOLVE_CACHE
-  {
-    String *key = NewString(t);
-    if (r) {
-      SwigType *r1;
-      Setattr(typedef_resolve_cache, key, r);
-      Setmeta(r, "scope", resolved_scope);
-      r1 = Copy(r);
-      Delete(r);
-      r = r1;
-    }
-    Delete(key);
+  /* Failed lookups are cached too, resolved_scope is still of interest */
+  entry = NewHash();
+  if (r) {
+    SwigType *rr = Copy(r);
+    Setattr(entry, "type", rr);
+    Delete(rr);
   }
+  if (resolved_scope)
+    Setattr(entry, "scope", resolved_scope);
+  cache_store(typedef_resolve_cache, t, entry, saved_lookups);
+  Delete(entry);
 #endif
   return r;
 }
@@ -1005,15 +1259,18 @@ SwigType *SwigType_typedef_resolve_all(const SwigType *t) {
   SwigType *n;
   SwigType *r;
   int count = 0;
+  Hash *entry;
+  Hash *saved_lookups;
 
   /* Check to see if the typedef resolve has been done before by checking the cache */
-  if (!typedef_all_cache) {
-    typedef_all_cache = NewHash();
-  }
-  r = Getattr(typedef_all_cache, t);
-  if (r) {
-    return Copy(r);
+  entry = Getattr(typedef_all_cache, t);
+  if (entry) {
+    cache_all_hits++;
+    cache_replay(entry);
+    return Copy(Getattr(entry, "type"));
   }
+  cache_all_misses++;
+  saved_lookups = cache_begin();
 
 #ifdef SWIG_DEBUG
   Printf(stdout, "SwigType_typedef_resolve_all start ... %s\n", t);
@@ -1031,11 +1288,11 @@ SwigType *SwigType_typedef_resolve_all(const SwigType *t) {
 
   /* Add the typedef to the cache for next time it is looked up */
   {
-    String *key;
     SwigType *rr = Copy(r);
-    key = NewString(t);
-    Setattr(typedef_all_cache, key, rr);
-    Delete(key);
+    entry = NewHash();
+    Setattr(entry, "type", rr);
+    cache_store(typedef_all_cache, t, entry, saved_lookups);
+    Delete(entry);
     Delete(rr);
   }
 #ifdef SWIG_DEBUG
@@ -1067,14 +1324,17 @@ SwigType *SwigType_typedef_qualified(const SwigType *t) {
   List *elements;
   String *result;
   int i, len;
+  Hash *entry;
+  Hash *saved_lookups;
 
-  if (!typedef_qualified_cache)
-    typedef_qualified_cache = NewHash();
-  result = Getattr(typedef_qualified_cache, t);
-  if (result) {
-    String *rc = Copy(result);
-    return rc;
+  entry = Getattr(typedef_qualified_cache, t);
+  if (entry) {
+    cache_qualified_hits++;
+    cache_replay(entry);
+    return Copy(Getattr(entry, "type"));
   }
+  cache_qualified_misses++;
+  saved_lookups = cache_begin();
 
   result = NewStringEmpty();
   elements = SwigType_split(t);
@@ -1141,6 +1401,9 @@ SwigType *SwigType_typedef_qualified(const SwigType *t) {
 	Iterator pi;
 	Parm *p;
 	List *parms;
+	tprefix = SwigType_templateprefix(e);
+	cache_record_symbol(tprefix);
+	Delete(tprefix);
 	ty = Swig_symbol_template_deftype(e, current_symtab);
 	e = ty;
 	parms = SwigType_parmlist(e);
@@ -1159,7 +1422,9 @@ SwigType *SwigType_typedef_qualified(const SwigType *t) {
 	      Node *lastnode = 0;
 	      String *value = Copy(p);
 	      while (1) {
-		Node *n = Swig_symbol_clookup(value, current_symtab);
+		Node *n;
+		cache_record_symbol(value);
+		n = Swig_symbol_clookup(value, current_symtab);
 		if (n == lastnode)
 		  break;
 		lastnode = n;
@@ -1232,6 +1497,9 @@ SwigType *SwigType_typedef_qualified(const SwigType *t) {
     } else if (SwigType_isarray(e)) {
       String *ndim;
       String *dim = SwigType_parm(e);
+      /* Names in the dimension are qualified through the symbol tables */
+      if (strspn(Char(dim), "0123456789") != (size_t)Len(dim))
+	cache_record(cache_uncacheable);
       ndim = Swig_symbol_string_qualify(dim, 0);
       Printf(result, "a(%s).", ndim);
       Delete(dim);
@@ -1242,11 +1510,11 @@ SwigType *SwigType_typedef_qualified(const SwigType *t) {
   }
   Delete(elements);
   {
-    String *key, *cresult;
-    key = NewString(t);
-    cresult = NewString(result);
-    Setattr(typedef_qualified_cache, key, cresult);
-    Delete(key);
+    String *cresult = NewString(result);
+    entry = NewHash();
+    Setattr(entry, "type", cresult);
+    cache_store(typedef_qualified_cache, t, entry, saved_lookups);
+    Delete(entry);
     Delete(cresult);
   }
   return result;
@@ -1305,6 +1573,7 @@ int SwigType_typedef_using(const_String_or_char_ptr name) {
 
   /* We set up a typedef  B --> A::B */
   Setattr(current_typetab, base, name);
+  cache_invalidate(base);
 
   /* Find the scope name where the symbol is defined */
   td = SwigType_typedef_resolve(name);
@@ -1332,6 +1601,7 @@ int SwigType_typedef_using(const_String_or_char_ptr name) {
 	Hash *ttab = Getattr(s, "typetab");
 	if (!Getattr(ttab, base) && defined_name) {
 	  Setattr(ttab, base, defined_name);
+	  cache_invalidate(base);
 	}
       }
     }
@@ -2115,6 +2385,8 @@ void SwigType_emit_type_table(File *f_forward, File *f_table) {
   List *mangled_list;
   List *table_list = NewList();
   int i = 0;
+  int ncasts = 0;
+  int index_size = 2;
 
   if (!r_mangled) {
     r_mangled = NewHash();
@@ -2237,6 +2509,7 @@ void SwigType_emit_type_table(File *f_forward, File *f_table) {
       } else {
 	Printf(cast_temp, "  {&_swigt_%s, 0, 0, 0},", ei.item);
       }
+      ncasts++;
       Delete(ckey);
 
       if (!Getattr(r_mangled, ei.item) && !Getattr(imported_types, ei.item)) {
@@ -2245,6 +2518,7 @@ void SwigType_emit_type_table(File *f_forward, File *f_table) {
 
 	Printf(cast, "static swig_cast_info _swigc_%s[] = {{&_swigt_%s, 0, 0, 0},{0, 0, 0, 0}};\n", ei.item, ei.item);
 	i++;
+	ncasts++;
 
 	Setattr(imported_types, ei.item, "1");
       }
@@ -2279,6 +2553,11 @@ void SwigType_emit_type_table(File *f_forward, File *f_table) {
   Printf(f_table, "%s\n", table);
   Printf(f_table, "%s\n", cast);
   Printf(f_table, "%s\n", cast_init);
+  /* hash table for SWIG_TypeCheck, a power of two at least twice the number of casts */
+  while (index_size < 2 * ncasts)
+    index_size *= 2;
+  Printf(f_table, "static swig_cast_index_entry swig_cast_index_initial[%d];\n", index_size);
+  Printf(f_table, "static swig_type_registry_node swig_type_registry_nodes[%d];\n", i + 1);
   Printf(f_table, "\n/* -------- TYPE CONVERSION AND EQUIVALENCE RULES (END) -------- */\n\n");
 
   Printf(f_forward, "static swig_type_info *swig_types[%d];\n", i + 1);